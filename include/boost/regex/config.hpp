@@ -323,6 +323,25 @@
 #  define BOOST_REGEX_MAX_STATE_COUNT 100000000
 #endif
 
+/*
+ * Texts no longer than BOOST_REGEX_AUTO_MEMOIZE_LIMIT / (length of expression)
+ * are matched as if match_memoize were set, when the expression is prone
+ * to excessive backtracking, see perl_matcher::init_flags:
+ */
+#ifndef BOOST_REGEX_AUTO_MEMOIZE_LIMIT
+#  define BOOST_REGEX_AUTO_MEMOIZE_LIMIT 4096
+#endif
+
+/*
+ * If the compiler supports "labels as values" then the non-recursive
+ * matcher can dispatch each state with a computed goto rather than a
+ * switch statement:
+ */
+#if !defined(BOOST_REGEX_NO_COMPUTED_GOTO) && !defined(BOOST_REGEX_HAS_COMPUTED_GOTO) && defined(__GNUC__) \
+      && !defined(__INTEL_COMPILER) && (defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)))
+#  define BOOST_REGEX_HAS_COMPUTED_GOTO
+#endif
+
 
 /*****************************************************************************
  *
@@ -71,8 +71,10 @@
 // used by the non-recursive algorithm.
 // #define BOOST_REGEX_BLOCKSIZE 4096
 
-// define this if you want to set the maximum number of memory blocks
-// used by the non-recursive algorithm.
+// define this if you want to set the maximum amount of memory, as a
+// number of blocks, used by the non-recursive algorithm: beyond the first
+// few the blocks grow larger, so this is a limit on memory rather than on
+// the number of blocks.
 // #define BOOST_REGEX_MAX_BLOCKS 1024
 
 // define this if you want to set the maximum number of memory blocks
@@ -81,6 +83,17 @@
 // if you don't want boost.regex to cache memory.
 // #define BOOST_REGEX_MAX_CACHE_BLOCKS 16
 
+// define this if you want the non-recursive matcher to dispatch states
+// with a switch statement, even when the compiler supports computed goto:
+// #define BOOST_REGEX_NO_COMPUTED_GOTO
+
+// define this if you want to change the size of the texts for which
+// failure memoization is used automatically with expressions which are
+// prone to excessive backtracking: memoization is used when the length of 
+// the text times the length of the expression is no more than this value,
+// zero turns it off.
+// #define BOOST_REGEX_AUTO_MEMOIZE_LIMIT 4096
+
 // define this if you want to be able to access extended capture
 // information in your sub_match's (caution this will slow things
 // down quite a bit).
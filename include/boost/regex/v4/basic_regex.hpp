@@ -21,6 +21,7 @@
 
 #include <boost/type_traits/is_same.hpp>
 #include <boost/functional/hash.hpp>
+#include <boost/cstdint.hpp>
 
 #ifdef BOOST_MSVC
 #pragma warning(push)
@@ -152,6 +153,43 @@ private:
    std::vector<name> m_sub_names;
 };
 
+//
+// struct re_shift_or:
+// a bit-parallel representation of an expression which matches a fixed
+// length sequence of single characters: bit i of m_masks[c] is clear if
+// character c can match the i'th character of the expression.
+//
+struct re_shift_or
+{
+#ifndef BOOST_NO_INT64_T
+   typedef boost::uint64_t mask_type;
+#else
+   typedef boost::uint32_t mask_type;
+#endif
+   struct group
+   {
+      int                      index;                     // index of the marked sub-expression
+      std::size_t              first;                     // offset of its start from the start of the match
+      std::size_t              second;                    // offset of its end from the start of the match
+   };
+   std::size_t                 m_length;                  // the number of characters matched
+   bool                        m_has_wild;                // whether any character is matched by '.'
+   bool                        m_has_newline_wild;        // whether any '.' depends upon match_not_dot_newline
+   mask_type                   m_masks[1 << CHAR_BIT];    // which characters match at each position
+   std::vector<group>          m_groups;                  // marked sub-expressions, in the order in which they close
+};
+
+//
+// struct re_case_fold:
+// the case insensitive translation of every narrow character, so that
+// the matcher can fold case with a table lookup rather than a call
+// to the traits class.
+//
+struct re_case_fold
+{
+   unsigned char               m_map[1 << CHAR_BIT];      // m_map[c] == traits.translate(c, true)
+};
+
 //
 // class regex_data:
 // represents the data we wish to expose to the matching algorithms.
@@ -186,7 +224,14 @@ struct regex_data : public named_subexpressions
       std::pair<
       std::size_t, std::size_t> > m_subs;                 // Position of sub-expressions within the *string*.
    bool                        m_has_recursions;          // whether we have recursive expressions;
+   bool                        m_has_backrefs;            // whether any state refers back to a marked sub-expression
+   std::size_t                 m_memo_repeats;            // one more than the largest state_id of a repeat which can be memoized, zero if none can.
+   bool                        m_backtracking_hazard;     // whether matching may take time exponential in the length of the text.
    bool                        m_disable_match_any;       // when set we need to disable the match_any flag as it causes different/buggy behaviour.
+   ::boost::shared_ptr<
+      BOOST_REGEX_DETAIL_NS::re_shift_or> m_shift_or;     // bit-parallel form of the machine, if it has one.
+   ::boost::shared_ptr<
+      BOOST_REGEX_DETAIL_NS::re_case_fold> m_case_fold;   // case folding table, for narrow characters matched case insensitively.
 };
 //
 // class basic_regex_implementation
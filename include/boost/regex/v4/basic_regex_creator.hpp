@@ -182,6 +182,34 @@ private:
    bool                      m_empty;           // whether we've added anything yet
    std::vector<digraph_type> m_equivalents;     // a list of equivalence classes
 };
+
+//
+// A branch of an alternation while it is being factored, see factor_alternatives:
+//
+struct alt_branch
+{
+   alt_branch(std::ptrdiff_t b, std::ptrdiff_t e) : begin(b), end(e), skip(0) {}
+   std::ptrdiff_t begin;   // offset of its first state
+   std::ptrdiff_t end;     // offset of the end of its last state
+   unsigned skip;          // how many characters of its leading literal are already matched
+};
+
+template <class charT>
+struct alt_branch_less
+{
+   alt_branch_less(void* b) : base(static_cast<const char*>(b)) {}
+   charT first(const alt_branch& a)const
+   {
+      // only used once a has been found to start with a literal:
+      const re_literal* lit = static_cast<const re_literal*>(static_cast<const void*>(base + a.begin));
+      return static_cast<const charT*>(static_cast<const void*>(lit + 1))[a.skip];
+   }
+   bool operator()(const alt_branch& a, const alt_branch& b)const
+   {
+      return first(a) < first(b);
+   }
+   const char* base;
+};
    
 template <class charT, class traits>
 class basic_regex_creator
@@ -228,6 +256,7 @@ public:
    re_syntax_base* append_set(const basic_char_set<charT, traits>& char_set, mpl::false_*);
    re_syntax_base* append_set(const basic_char_set<charT, traits>& char_set, mpl::true_*);
    void finalize(const charT* p1, const charT* p2);
+   void factor_alternatives(std::ptrdiff_t first_alt, std::size_t count);
 protected:
    regex_data<charT, traits>*    m_pdata;              // pointer to the basic_regex_data struct we are filling in
    const ::boost::regex_traits_wrapper<traits>&  
@@ -239,12 +268,16 @@ protected:
    unsigned                      m_backrefs;           // bitmask of permitted backrefs
    boost::uintmax_t              m_bad_repeats;        // bitmask of repeats we can't deduce a startmap for;
    bool                          m_has_recursions;     // set when we have recursive expresisons to fixup
+   bool                          m_has_backtracking_hazard; // set when matching may take exponential time, see probe_backtracking
    std::vector<bool>             m_recursion_checks;   // notes which recursions we've followed while analysing this expression
    typename traits::char_class_type m_word_mask;       // mask used to determine if a character is a word character
    typename traits::char_class_type m_mask_space;      // mask used to determine if a character is a word character
    typename traits::char_class_type m_lower_mask;       // mask used to determine if a character is a lowercase character
    typename traits::char_class_type m_upper_mask;      // mask used to determine if a character is an uppercase character
    typename traits::char_class_type m_alpha_mask;      // mask used to determine if a character is an alphabetic character
+   charT                         m_case_translations[1u << CHAR_BIT]; // case insensitive translation of each narrow character
+   bool                          m_has_case_translations; // set once m_case_translations has been filled in
+   int                           m_trivial_translate;  // result of has_trivial_translate, or -1 if not known yet
 private:
    basic_regex_creator& operator=(const basic_regex_creator&);
    basic_regex_creator(const basic_regex_creator&);
@@ -255,16 +288,39 @@ private:
    int calculate_backstep(re_syntax_base* state);
    void create_startmap(re_syntax_base* state, unsigned char* l_map, unsigned int* pnull, unsigned char mask);
    unsigned get_restart_type(re_syntax_base* state);
+   bool has_trivial_translate();
+   charT translate_narrow(unsigned i, bool icase)
+   {
+      // the translation of the narrow character i, which has to call into the
+      // locale when case insensitive, so those are only looked up once:
+      if(!icase)
+         return m_traits.translate(static_cast<charT>(i), false);
+      if(!m_has_case_translations)
+         create_case_translations();
+      return m_case_translations[i];
+   }
+   void create_case_translations();
    void set_all_masks(unsigned char* bits, unsigned char);
    bool is_bad_repeat(re_syntax_base* pt);
    void set_bad_repeat(re_syntax_base* pt);
    syntax_element_type get_repeat_type(re_syntax_base* state);
    void probe_leading_repeat(re_syntax_base* state);
+   void probe_backtracking();
+   void probe_possessive_repeats();
+   void remove_inert_braces();
+   void create_shift_or();
+   void create_case_fold();
+   bool append_shift_or_position(re_shift_or* pso, const re_syntax_base* state, bool l_icase);
+   const charT* leading_literal(alt_branch& b, void* base, unsigned& len);
+   void append_alternatives(std::vector<alt_branch>& branches, void* base, std::vector<std::ptrdiff_t>& jumps);
+   void append_branch(alt_branch& b, void* base);
+   void append_literal_string(const charT* p, unsigned len);
+   void append_copy(void* base, std::ptrdiff_t first, std::ptrdiff_t last);
 };
 
 template <class charT, class traits>
 basic_regex_creator<charT, traits>::basic_regex_creator(regex_data<charT, traits>* data)
-   : m_pdata(data), m_traits(*(data->m_ptraits)), m_last_state(0), m_repeater_id(0), m_has_backrefs(false), m_backrefs(0), m_has_recursions(false)
+   : m_pdata(data), m_traits(*(data->m_ptraits)), m_last_state(0), m_repeater_id(0), m_has_backrefs(false), m_backrefs(0), m_has_recursions(false), m_has_backtracking_hazard(false)
 {
    m_pdata->m_data.clear();
    m_pdata->m_status = ::boost::regex_constants::error_ok;
@@ -284,13 +340,16 @@ basic_regex_creator<charT, traits>::basic_regex_creator(regex_data<charT, traits
    BOOST_ASSERT(m_lower_mask != 0); 
    BOOST_ASSERT(m_upper_mask != 0); 
    BOOST_ASSERT(m_alpha_mask != 0); 
+   m_has_case_translations = false;
+   m_trivial_translate = -1;
 }
 
 template <class charT, class traits>
 re_syntax_base* basic_regex_creator<charT, traits>::append_state(syntax_element_type t, std::size_t s)
 {
-   // if the state is a backref then make a note of it:
-   if(t == syntax_element_backref)
+   // if the state is a backref (or a condition that depends on
+   // one) then make a note of it:
+   if((t == syntax_element_backref) || (t == syntax_element_assert_backref))
       this->m_has_backrefs = true;
    // append a new state, start by aligning our last one:
    m_pdata->m_data.align();
@@ -530,11 +589,20 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
    last = char_set.singles_end();
    while(first != last)
    {
-      for(unsigned int i = 0; i < (1 << CHAR_BIT); ++i)
+      charT c = this->m_traits.translate(first->first, this->m_icase);
+      if(!this->m_icase && has_trivial_translate())
       {
-         if(this->m_traits.translate(static_cast<charT>(i), this->m_icase)
-            == this->m_traits.translate(first->first, this->m_icase))
-            result->_map[i] = true;
+         // only the character itself can match:
+         if(static_cast<charT>(static_cast<unsigned char>(c)) == c)
+            result->_map[static_cast<unsigned char>(c)] = true;
+      }
+      else
+      {
+         for(unsigned int i = 0; i < (1 << CHAR_BIT); ++i)
+         {
+            if(translate_narrow(i, this->m_icase) == c)
+               result->_map[i] = true;
+         }
       }
       ++first;
    }
@@ -651,6 +719,220 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
    return result;
 }
 
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::factor_alternatives(std::ptrdiff_t first_alt, std::size_t count)
+{
+   //
+   // Called by the parser once the alternation of count + 1 branches starting
+   // at first_alt is complete, and nothing has been added after it.  Branches
+   // which start with literals sharing a leading character are rewritten so
+   // that the characters they have in common are matched only once, for
+   // example "abc|abd|x" becomes "ab(?:c|d)|x".  Branches which start with
+   // different characters can never both match at the same place, so their
+   // order within a run of such branches doesn't matter, but a branch is
+   // never moved past one which doesn't start with a literal.
+   //
+   std::ptrdiff_t end = m_pdata->m_data.size();
+   std::vector<alt_branch> branches;
+   branches.reserve(count + 1);
+   std::ptrdiff_t pos = first_alt;
+   for(std::size_t i = 0; i < count; ++i)
+   {
+      re_alt* alt = static_cast<re_alt*>(getaddress(pos));
+      BOOST_ASSERT(alt->type == syntax_element_alt);
+      std::ptrdiff_t next_alt = pos + alt->alt.i;
+      // every branch but the last is followed by a jump to the end:
+      branches.push_back(alt_branch(pos + alt->next.i - first_alt, next_alt - re_jump_size - first_alt));
+      pos = next_alt;
+   }
+   branches.push_back(alt_branch(pos - first_alt, end - first_alt));
+   void* base = getaddress(first_alt);
+   //
+   // Find out whether there is anything to do before going any further:
+   //
+   bool found = false;
+   std::vector<charT> leading;
+   unsigned len = 0;
+   for(std::size_t i = 0; (i < branches.size()) && !found; ++i)
+   {
+      leading.clear();
+      const charT* p;
+      while((i < branches.size()) && (0 != (p = leading_literal(branches[i], base, len))))
+      {
+         leading.push_back(*p);
+         ++i;
+      }
+      std::sort(leading.begin(), leading.end());
+      found = std::adjacent_find(leading.begin(), leading.end()) != leading.end();
+   }
+   if(!found)
+      return;
+   //
+   // Verbs which depend upon which alternative is being tried rule this out:
+   //
+   for(pos = first_alt; pos < end; )
+   {
+      re_syntax_base* state = getaddress(pos);
+      if((state->type == syntax_element_commit) || (state->type == syntax_element_then))
+         return;
+      if(state->next.i == 0)
+         break;
+      pos += state->next.i;
+   }
+   //
+   // Take a copy of the alternation, and then rebuild it in place:
+   //
+   raw_storage saved(end - first_alt);
+   base = saved.extend(end - first_alt);
+   std::memcpy(base, getaddress(first_alt), end - first_alt);
+   m_pdata->m_data.clear();
+   m_pdata->m_data.extend(first_alt);
+   m_last_state = 0;
+   std::vector<std::ptrdiff_t> jumps;
+   append_alternatives(branches, base, jumps);
+   m_pdata->m_data.align();
+   for(std::vector<std::ptrdiff_t>::const_iterator i = jumps.begin(); i != jumps.end(); ++i)
+      static_cast<re_jump*>(getaddress(*i))->alt.i = m_pdata->m_data.size() - *i;
+}
+
+template <class charT, class traits>
+const charT* basic_regex_creator<charT, traits>::leading_literal(alt_branch& b, void* base, unsigned& len)
+{
+   //
+   // Returns the characters which b starts with and which have not yet been
+   // matched, if any, stepping over a leading literal which has been used up:
+   //
+   while(b.begin != b.end)
+   {
+      re_syntax_base* state = getaddress(b.begin, base);
+      if(state->type != syntax_element_literal)
+         return 0;
+      re_literal* lit = static_cast<re_literal*>(state);
+      if(b.skip < lit->length)
+      {
+         len = lit->length - b.skip;
+         return static_cast<const charT*>(static_cast<const void*>(lit + 1)) + b.skip;
+      }
+      b.begin = state->next.i ? b.begin + state->next.i : b.end;
+      b.skip = 0;
+   }
+   return 0;
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::append_alternatives(std::vector<alt_branch>& branches, void* base, std::vector<std::ptrdiff_t>& jumps)
+{
+   //
+   // Sort each run of branches which start with a literal by their first
+   // character, keeping their order otherwise:
+   //
+   unsigned len = 0;
+   for(std::size_t i = 0; i < branches.size(); ++i)
+   {
+      std::size_t j = i;
+      while((j < branches.size()) && leading_literal(branches[j], base, len))
+         ++j;
+      std::stable_sort(branches.begin() + i, branches.begin() + j, alt_branch_less<charT>(base));
+      i = j;
+   }
+   //
+   // Then each group of branches with the same first character becomes a
+   // single branch:
+   //
+   std::vector<std::size_t> groups;
+   const charT* last = 0;
+   for(std::size_t i = 0; i < branches.size(); ++i)
+   {
+      const charT* p = leading_literal(branches[i], base, len);
+      if(!p || !last || (*p != *last))
+         groups.push_back(i);
+      last = p;
+   }
+   groups.push_back(branches.size());
+   for(std::size_t g = 0; g + 1 < groups.size(); ++g)
+   {
+      bool last_group = (g + 2 == groups.size());
+      std::ptrdiff_t alt_offset = 0;
+      if(!last_group)
+         alt_offset = getoffset(append_state(syntax_element_alt, re_alt_size));
+      if(groups[g + 1] - groups[g] == 1)
+         append_branch(branches[groups[g]], base);
+      else
+      {
+         // match the characters the group has in common, then what remains of each branch:
+         const charT* p = leading_literal(branches[groups[g]], base, len);
+         for(std::size_t k = groups[g] + 1; k < groups[g + 1]; ++k)
+         {
+            unsigned len2 = 0;
+            const charT* p2 = leading_literal(branches[k], base, len2);
+            unsigned common = 1;
+            while((common < len) && (common < len2) && (p[common] == p2[common]))
+               ++common;
+            len = common;
+         }
+         append_literal_string(p, len);
+         std::vector<alt_branch> rest(branches.begin() + groups[g], branches.begin() + groups[g + 1]);
+         for(std::vector<alt_branch>::iterator k = rest.begin(); k != rest.end(); ++k)
+            k->skip += len;
+         append_alternatives(rest, base, jumps);
+      }
+      if(!last_group)
+      {
+         jumps.push_back(getoffset(append_state(syntax_element_jump, sizeof(re_jump))));
+         m_pdata->m_data.align();
+         static_cast<re_alt*>(getaddress(alt_offset))->alt.i = m_pdata->m_data.size() - alt_offset;
+      }
+   }
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::append_branch(alt_branch& b, void* base)
+{
+   unsigned len = 0;
+   const charT* p = leading_literal(b, base, len);
+   if(p && b.skip)
+   {
+      // the part of the literal the group didn't have in common, then the states which follow it:
+      append_literal_string(p, len);
+      re_syntax_base* state = getaddress(b.begin, base);
+      append_copy(base, state->next.i ? b.begin + state->next.i : b.end, b.end);
+   }
+   else
+      append_copy(base, b.begin, b.end);
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::append_literal_string(const charT* p, unsigned len)
+{
+   re_literal* result = static_cast<re_literal*>(append_state(syntax_element_literal, sizeof(re_literal) + sizeof(charT) * len));
+   result->length = len;
+   std::copy(p, p + len, static_cast<charT*>(static_cast<void*>(result + 1)));
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::append_copy(void* base, std::ptrdiff_t first, std::ptrdiff_t last)
+{
+   if(first == last)
+      return;
+   m_pdata->m_data.align();
+   std::ptrdiff_t off = m_pdata->m_data.size();
+   if(m_last_state)
+      m_last_state->next.i = off - getoffset(m_last_state);
+   std::memcpy(m_pdata->m_data.extend(last - first), getaddress(first, base), last - first);
+   //
+   // The states keep their offsets relative to one another, find the last of them:
+   //
+   std::ptrdiff_t pos = off;
+   for(;;)
+   {
+      re_syntax_base* state = getaddress(pos);
+      if((state->next.i == 0) || (pos + state->next.i >= off + (last - first)))
+         break;
+      pos += state->next.i;
+   }
+   m_last_state = getaddress(pos);
+}
+
 template <class charT, class traits>
 void basic_regex_creator<charT, traits>::finalize(const charT* p1, const charT* p2)
 {
@@ -682,6 +964,7 @@ void basic_regex_creator<charT, traits>::finalize(const charT* p1, const charT*
    }
    else
       m_pdata->m_has_recursions = false;
+   m_pdata->m_has_backrefs = m_has_backrefs;
    // create nested startmaps:
    create_startmaps(m_pdata->m_first_state);
    // create main startmap:
@@ -696,6 +979,17 @@ void basic_regex_creator<charT, traits>::finalize(const charT* p1, const charT*
    m_pdata->m_restart_type = get_restart_type(m_pdata->m_first_state);
    // optimise a leading repeat if there is one:
    probe_leading_repeat(m_pdata->m_first_state);
+   // see if we can search for the expression with the bit-parallel matcher:
+   create_shift_or();
+   // look for exponential backtracking, and repeats we can memoize:
+   probe_backtracking();
+   // find the repeats which never need to give back what they've matched:
+   probe_possessive_repeats();
+   // tabulate case folding if we'll need it:
+   create_case_fold();
+   // if we've been asked to spend more time optimising the machine then do so:
+   if(m_pdata->m_flags & regbase::optimize)
+      remove_inert_braces();
 }
 
 template <class charT, class traits>
@@ -1076,10 +1370,20 @@ void basic_regex_creator<charT, traits>::create_startmap(re_syntax_base* state,
          {
             l_map[0] |= mask_init;
             charT first_char = *static_cast<charT*>(static_cast<void*>(static_cast<re_literal*>(state) + 1));
-            for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
+            if(!l_icase && has_trivial_translate())
             {
-               if(m_traits.translate(static_cast<charT>(i), l_icase) == first_char)
-                  l_map[i] |= mask;
+               // only the character itself can match:
+               unsigned char c = static_cast<unsigned char>(first_char);
+               if(static_cast<charT>(c) == first_char)
+                  l_map[c] |= mask;
+            }
+            else
+            {
+               for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
+               {
+                  if(translate_narrow(i, l_icase) == first_char)
+                     l_map[i] |= mask;
+               }
             }
          }
          return;
@@ -1217,11 +1521,19 @@ void basic_regex_creator<charT, traits>::create_startmap(re_syntax_base* state,
          if(l_map)
          {
             l_map[0] |= mask_init;
-            for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
+            const unsigned char* set_map = static_cast<re_set*>(state)->_map;
+            if(!l_icase && has_trivial_translate())
             {
-               if(static_cast<re_set*>(state)->_map[
-                  static_cast<unsigned char>(m_traits.translate(static_cast<charT>(i), l_icase))])
-                  l_map[i] |= mask;
+               for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
+                  l_map[i] |= set_map[i] ? mask : 0;
+            }
+            else
+            {
+               for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
+               {
+                  if(set_map[static_cast<unsigned char>(translate_narrow(i, l_icase))])
+                     l_map[i] |= mask;
+               }
             }
          }
          return;
@@ -1378,6 +1690,17 @@ unsigned basic_regex_creator<charT, traits>::get_restart_type(re_syntax_base* st
          return regbase::restart_buf;
       case syntax_element_restart_continue:
          return regbase::restart_continue;
+      case syntax_element_literal:
+         // if the whole expression is a single literal string then we
+         // can search for it directly rather than via the startmap,
+         // note that the narrow character search compares characters
+         // without translating them, so the traits class must not
+         // alter characters in case-sensitive mode for this to work:
+         if((state->next.p->type == syntax_element_match)
+            && ((sizeof(charT) != 1) || has_trivial_translate()))
+            return regbase::restart_fixed_lit;
+         state = 0;
+         continue;
       default:
          state = 0;
          continue;
@@ -1386,6 +1709,37 @@ unsigned basic_regex_creator<charT, traits>::get_restart_type(re_syntax_base* st
    return regbase::restart_any;
 }
 
+template <class charT, class traits>
+bool basic_regex_creator<charT, traits>::has_trivial_translate()
+{
+   if(m_trivial_translate < 0)
+   {
+      m_trivial_translate = 1;
+      for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+      {
+         if(m_traits.translate(static_cast<charT>(i), false) != static_cast<charT>(i))
+         {
+            m_trivial_translate = 0;
+            break;
+         }
+      }
+   }
+   return m_trivial_translate != 0;
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::create_case_translations()
+{
+   //
+   // Start maps, sets and the bit-parallel matcher all need the case
+   // insensitive translation of every narrow character, and would otherwise 
+   // ask the locale for them all over again for each state:
+   //
+   for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+      m_case_translations[i] = m_traits.translate(static_cast<charT>(i), true);
+   m_has_case_translations = true;
+}
+
 template <class charT, class traits>
 void basic_regex_creator<charT, traits>::set_all_masks(unsigned char* bits, unsigned char mask)
 {
@@ -1534,6 +1888,413 @@ void basic_regex_creator<charT, traits>::probe_leading_repeat(re_syntax_base* st
    }while(state);
 }
 
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::probe_backtracking()
+{
+   //
+   // Walk the machine keeping track of the repeats which enclose each state,
+   // this tells us two things:
+   //
+   // * Whether an unbounded repeat contains something which can match the
+   //   same text in more than one way: either another unbounded repeat, or an
+   //   alternation whose branches can start with the same character.  Failing
+   //   to match such an expression can take time exponential in the length 
+   //   of the text, so the no_backtracking_hazards option rejects them.
+   // * Which repeats can record the positions at which they have failed, when
+   //   matching with match_memoize.  For that the outcome of entering the repeat
+   //   must depend only on the position in the text: so there must be no 
+   //   back-references, recursions, conditionals or verbs, the repeat must be 
+   //   unbounded, and every repeat which encloses it must be unbounded with a 
+   //   minimum of at most one, so that their counts can't alter what happens next.
+   //
+   static const std::size_t unbounded = (std::numeric_limits<std::size_t>::max)();
+   bool can_memoize = !m_has_backrefs && !m_has_recursions;
+   std::vector<re_repeat*> enclosing;
+   std::vector<re_repeat*> candidates;
+   re_syntax_base* state = m_pdata->m_first_state;
+   while(state)
+   {
+      // a general repeat ends with a jump back to the repeat, followed by the state alt.p points to:
+      while(!enclosing.empty() && (getoffset(state) >= getoffset(enclosing.back()->alt.p)))
+         enclosing.pop_back();
+      bool in_unbounded = false;
+      bool in_counted = false;
+      for(typename std::vector<re_repeat*>::const_iterator i = enclosing.begin(); i != enclosing.end(); ++i)
+      {
+         if((*i)->max == unbounded)
+            in_unbounded = true;
+         if(((*i)->max != unbounded) || ((*i)->min > 1))
+            in_counted = true;
+      }
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+         if(static_cast<re_brace*>(state)->index == -4)
+            can_memoize = false;
+         break;
+      case syntax_element_accept:
+      case syntax_element_commit:
+      case syntax_element_then:
+         can_memoize = false;
+         break;
+      case syntax_element_alt:
+         if(in_unbounded)
+         {
+            const re_alt* alt = static_cast<const re_alt*>(state);
+            if((alt->can_be_null & mask_take) && (alt->can_be_null & mask_skip))
+               m_has_backtracking_hazard = true;
+            for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+            {
+               if((alt->_map[c] & mask_take) && (alt->_map[c] & mask_skip))
+                  m_has_backtracking_hazard = true;
+            }
+         }
+         break;
+      case syntax_element_rep:
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         {
+            re_repeat* rep = static_cast<re_repeat*>(state);
+            rep->memoize = false;
+            if(in_unbounded && (rep->max == unbounded))
+               m_has_backtracking_hazard = true;
+            if(state->type == syntax_element_rep)
+            {
+               if((rep->max == unbounded) && !in_counted)
+                  candidates.push_back(rep);
+               enclosing.push_back(rep);
+            }
+            break;
+         }
+      default:
+         break;
+      }
+      state = state->next.p;
+   }
+   m_pdata->m_backtracking_hazard = m_has_backtracking_hazard;
+   m_pdata->m_memo_repeats = 0;
+   if(can_memoize)
+   {
+      for(typename std::vector<re_repeat*>::const_iterator i = candidates.begin(); i != candidates.end(); ++i)
+      {
+         (*i)->memoize = true;
+         m_pdata->m_memo_repeats = (std::max)(m_pdata->m_memo_repeats, static_cast<std::size_t>((*i)->state_id + 1));
+      }
+   }
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::probe_possessive_repeats()
+{
+   //
+   // A greedy repeat of a single character or set need never give back 
+   // any of the characters it has matched if what follows it can't match 
+   // a null string, and can't start with any character that the repeat 
+   // matches: backtracking would leave us at a character that the rest of 
+   // the expression must reject, so for example "\d+\s" or "[^,]*," 
+   // needn't save any backtracking state at all.  Our startmaps tell us
+   // both things, except that they can't see past the end of a recursion,
+   // nor whether a wide character above 0xFF can match:
+   //
+   if(m_has_recursions)
+      return;
+   bool l_icase = m_icase;
+   for(re_syntax_base* state = m_pdata->m_first_state; state; state = state->next.p)
+   {
+      switch(state->type)
+      {
+      case syntax_element_toggle_case:
+         l_icase = static_cast<re_case*>(state)->icase;
+         break;
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         {
+            re_repeat* rep = static_cast<re_repeat*>(state);
+            if(!rep->greedy || (rep->min == rep->max) || (rep->can_be_null & mask_skip))
+               break;
+            if(sizeof(charT) > 1)
+            {
+               // only a case sensitive literal is sure not to match a wide character:
+               if((state->type != syntax_element_char_rep) || l_icase || !has_trivial_translate())
+                  break;
+               charT c = *static_cast<charT*>(static_cast<void*>(static_cast<re_literal*>(rep->next.p) + 1));
+               if(static_cast<charT>(static_cast<unsigned char>(c)) != c)
+                  break;
+            }
+            unsigned i = 0;
+            while((i < (1u << CHAR_BIT)) && !((rep->_map[i] & mask_take) && (rep->_map[i] & mask_skip)))
+               ++i;
+            rep->possessive = (i == (1u << CHAR_BIT));
+         }
+         break;
+      default:
+         break;
+      }
+   }
+}
+
+inline re_syntax_base* skip_inert_braces(re_syntax_base* state)
+{
+   while(state 
+      && ((state->type == syntax_element_startmark) || (state->type == syntax_element_endmark)) 
+      && (static_cast<re_brace*>(state)->index == 0))
+      state = state->next.p;
+   return state;
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::remove_inert_braces()
+{
+   //
+   // Parentheses with an index of zero - non-marking groups, and all groups
+   // when nosubs is set - do nothing at match time other than set the 
+   // case sensitivity, so if that can never change we can unlink them from 
+   // the machine and save a state transition each time one is entered or left.
+   // Recursions jump to a specific opening parenthesis, so leave those alone:
+   //
+   if(m_has_recursions)
+      return;
+   bool l_icase = (m_pdata->m_flags & regbase::icase) != 0;
+   re_syntax_base* state = m_pdata->m_first_state;
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_toggle_case:
+         return;
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+         if(static_cast<re_brace*>(state)->icase != l_icase)
+            return;
+         break;
+      default:
+         break;
+      }
+      state = state->next.p;
+   }
+   //
+   // Now update every pointer in the machine so that it skips over the
+   // inert states:
+   //
+   m_pdata->m_first_state = skip_inert_braces(m_pdata->m_first_state);
+   state = m_pdata->m_first_state;
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_rep:
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+      case syntax_element_alt:
+      case syntax_element_jump:
+         static_cast<re_jump*>(state)->alt.p = skip_inert_braces(static_cast<re_jump*>(state)->alt.p);
+         BOOST_FALLTHROUGH;
+      default:
+         state->next.p = skip_inert_braces(state->next.p);
+      }
+      state = state->next.p;
+   }
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::create_shift_or()
+{
+   //
+   // If the machine is nothing more than a short fixed length sequence of 
+   // single character matches, then we can find it by simulating the machine 
+   // with the bits of a single integer, one bit per character:
+   //
+   if((sizeof(charT) != 1) || m_has_backrefs || m_has_recursions 
+      || (m_pdata->m_restart_type != regbase::restart_any))
+      return;
+   //
+   // Most expressions aren't suitable, so find that out before doing 
+   // any real work:
+   //
+   std::size_t length = 0;
+   for(re_syntax_base* state = m_pdata->m_first_state; state->type != syntax_element_match; )
+   {
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+         if(static_cast<re_brace*>(state)->index < 0)
+            return;
+         break;
+      case syntax_element_toggle_case:
+         break;
+      case syntax_element_literal:
+         length += static_cast<re_literal*>(state)->length;
+         break;
+      case syntax_element_set:
+      case syntax_element_wild:
+         ++length;
+         break;
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+         if(static_cast<re_repeat*>(state)->min != static_cast<re_repeat*>(state)->max)
+            return;
+         length += static_cast<re_repeat*>(state)->min;
+         state = static_cast<re_repeat*>(state)->alt.p;
+         continue;
+      default:
+         return;
+      }
+      if(length > sizeof(re_shift_or::mask_type) * CHAR_BIT)
+         return;
+      state = state->next.p;
+   }
+   if(length == 0)
+      return;
+   boost::shared_ptr<re_shift_or> pso(new re_shift_or);
+   pso->m_length = 0;
+   pso->m_has_wild = false;
+   pso->m_has_newline_wild = false;
+   std::fill(pso->m_masks, pso->m_masks + (1 << CHAR_BIT), ~static_cast<re_shift_or::mask_type>(0));
+   std::vector<re_shift_or::group> open_groups;
+   bool l_icase = (m_pdata->m_flags & regbase::icase) != 0;
+   re_syntax_base* state = m_pdata->m_first_state;
+   while(state->type != syntax_element_match)
+   {
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+         {
+            int index = static_cast<re_brace*>(state)->index;
+            if(index < 0)
+               return;
+            l_icase = static_cast<re_brace*>(state)->icase;
+            if(index == 0)
+               break;
+            if(state->type == syntax_element_startmark)
+            {
+               re_shift_or::group g = { index, pso->m_length, 0 };
+               open_groups.push_back(g);
+            }
+            else
+            {
+               BOOST_ASSERT(!open_groups.empty() && (open_groups.back().index == index));
+               open_groups.back().second = pso->m_length;
+               pso->m_groups.push_back(open_groups.back());
+               open_groups.pop_back();
+            }
+            break;
+         }
+      case syntax_element_toggle_case:
+         l_icase = static_cast<re_case*>(state)->icase;
+         break;
+      case syntax_element_literal:
+      case syntax_element_set:
+      case syntax_element_wild:
+         if(!append_shift_or_position(pso.get(), state, l_icase))
+            return;
+         break;
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+         {
+            re_repeat* rep = static_cast<re_repeat*>(state);
+            if(rep->min != rep->max)
+               return;
+            for(std::size_t i = 0; i < rep->min; ++i)
+            {
+               if(!append_shift_or_position(pso.get(), rep->next.p, l_icase))
+                  return;
+            }
+            state = rep->alt.p;
+            continue;
+         }
+      default:
+         return;
+      }
+      state = state->next.p;
+   }
+   if(pso->m_length)
+      m_pdata->m_shift_or = pso;
+}
+
+template <class charT, class traits>
+bool basic_regex_creator<charT, traits>::append_shift_or_position(re_shift_or* pso, const re_syntax_base* state, bool l_icase)
+{
+   std::size_t count = state->type == syntax_element_literal ? static_cast<const re_literal*>(state)->length : 1;
+   if(pso->m_length + count > sizeof(re_shift_or::mask_type) * CHAR_BIT)
+      return false;
+   re_shift_or::mask_type bit = static_cast<re_shift_or::mask_type>(1u) << pso->m_length;
+   switch(state->type)
+   {
+   case syntax_element_literal:
+      {
+         //
+         // Rather than compare every character with each position in turn, note
+         // the positions at which each value occurs, and then look up the 
+         // translation of each character in that (create_shift_or only calls
+         // us for narrow characters):
+         //
+         const charT* p = reinterpret_cast<const charT*>(static_cast<const re_literal*>(state) + 1);
+         re_shift_or::mask_type positions[1 << CHAR_BIT] = { 0, };
+         for(std::size_t n = 0; n < count; ++n)
+            positions[static_cast<unsigned char>(p[n])] |= bit << n;
+         for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+            pso->m_masks[c] &= ~positions[static_cast<unsigned char>(translate_narrow(c, l_icase))];
+         break;
+      }
+   case syntax_element_set:
+      for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+      {
+         if(static_cast<const re_set*>(state)->_map[static_cast<unsigned char>(translate_narrow(c, l_icase))])
+            pso->m_masks[c] &= ~bit;
+      }
+      break;
+   default:
+      BOOST_ASSERT(state->type == syntax_element_wild);
+      // assume the default behaviour for '.', the matcher will not
+      // use us if the match flags say otherwise:
+      pso->m_has_wild = true;
+      if(static_cast<const re_dot*>(state)->mask == dont_care)
+         pso->m_has_newline_wild = true;
+      for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+      {
+         if(!is_separator(static_cast<charT>(c)) || (static_cast<const re_dot*>(state)->mask != force_not_newline))
+            pso->m_masks[c] &= ~bit;
+      }
+      break;
+   }
+   pso->m_length += count;
+   return true;
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::create_case_fold()
+{
+   //
+   // If any part of the expression is case insensitive, then tabulate the
+   // translation of each narrow character, so that the matcher doesn't
+   // have to call the traits class (and usually the locale) every time
+   // it compares a character:
+   //
+   if(sizeof(charT) != 1)
+      return;
+   bool l_icase = (m_pdata->m_flags & regbase::icase) != 0;
+   for(re_syntax_base* state = m_pdata->m_first_state; state && !l_icase; state = state->next.p)
+   {
+      if(state->type == syntax_element_toggle_case)
+         l_icase = static_cast<re_case*>(state)->icase;
+   }
+   if(!l_icase)
+      return;
+   boost::shared_ptr<re_case_fold> pcf(new re_case_fold);
+   for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+      pcf->m_map[c] = static_cast<unsigned char>(translate_narrow(c, true));
+   m_pdata->m_case_fold = pcf;
+}
+
 
 } // namespace BOOST_REGEX_DETAIL_NS
 
@@ -1555,4 +2316,3 @@ void basic_regex_creator<charT, traits>::probe_leading_repeat(re_syntax_base* st
 #endif
 
 #endif
-
@@ -71,7 +71,7 @@ public:
    bool parse_perl_verb();
    bool match_verb(const char*);
    bool add_emacs_code(bool negate);
-   bool unwind_alts(std::ptrdiff_t last_paren_start);
+   bool unwind_alts(std::ptrdiff_t last_paren_start, bool factor = true);
    digraph<charT> get_next_set_literal(basic_char_set<charT, traits>& char_set);
    charT unescape_character();
    regex_constants::syntax_option_type parse_options();
@@ -140,6 +140,11 @@ void basic_regex_parser<charT, traits>::parse(const charT* p1, const charT* p2,
          re_brace* br = static_cast<re_brace*>(this->append_state(syntax_element_startmark, sizeof(re_brace)));
          br->index = 0;
          br->icase = this->flags() & regbase::icase;
+         //
+         // Alternatives go after it, so that it leads every one of them:
+         //
+         this->m_pdata->m_data.align();
+         m_alt_insert_point = this->m_pdata->m_data.size();
          break;
       }
    case regbase::basic_syntax_group:
@@ -176,6 +181,12 @@ void basic_regex_parser<charT, traits>::parse(const charT* p1, const charT* p2,
    // fill in our sub-expression count:
    this->m_pdata->m_mark_count = 1 + m_mark_count;
    this->finalize(p1, p2);
+   if((l_flags & regbase::no_backtracking_hazards) && this->m_has_backtracking_hazard && (this->m_pdata->m_status == 0))
+   {
+      fail(regex_constants::error_complexity, ::boost::BOOST_REGEX_DETAIL_NS::distance(m_base, m_end), 
+         "The expression contains nested unbounded repeats, or an unbounded repeat of alternatives which can match the same text, "
+         "and may take exponential time to match.");
+   }
 }
 
 template <class charT, class traits>
@@ -1023,6 +1034,7 @@ bool basic_regex_parser<charT, traits>::parse_repeat(std::size_t low, std::size_
    rep->max = high;
    rep->greedy = greedy;
    rep->leading = false;
+   rep->possessive = false;
    // store our repeater position for later:
    std::ptrdiff_t rep_off = this->getoffset(rep);
    // and append a back jump to the repeat:
@@ -2507,9 +2519,10 @@ option_group_jump:
    //
    parse_all();
    //
-   // Unwind alternatives:
+   // Unwind alternatives, those of a conditional expression are its
+   // two cases so are not factored:
    //
-   if(0 == unwind_alts(last_paren_start))
+   if(0 == unwind_alts(last_paren_start, markid != -4))
    {
       // Rewind to start of (? sequence:
       --m_position;
@@ -3012,7 +3025,7 @@ regex_constants::syntax_option_type basic_regex_parser<charT, traits>::parse_opt
 }
 
 template <class charT, class traits>
-bool basic_regex_parser<charT, traits>::unwind_alts(std::ptrdiff_t last_paren_start)
+bool basic_regex_parser<charT, traits>::unwind_alts(std::ptrdiff_t last_paren_start, bool factor)
 {
    //
    // If we didn't actually add any states after the last 
@@ -3034,6 +3047,8 @@ bool basic_regex_parser<charT, traits>::unwind_alts(std::ptrdiff_t last_paren_st
    // 
    // Fix up our alternatives:
    //
+   std::ptrdiff_t first_jump = -1;
+   std::size_t count = 0;
    while(m_alt_jumps.size() && (m_alt_jumps.back() > last_paren_start))
    {
       //
@@ -3046,6 +3061,28 @@ bool basic_regex_parser<charT, traits>::unwind_alts(std::ptrdiff_t last_paren_st
       re_jump* jmp = static_cast<re_jump*>(this->getaddress(jump_offset));
       BOOST_ASSERT(jmp->type == syntax_element_jump);
       jmp->alt.i = this->m_pdata->m_data.size() - jump_offset;
+      first_jump = jump_offset;
+      ++count;
+   }
+   if(factor && count)
+   {
+      //
+      // Find the first alternative, it is the first state after the start
+      // of this block whose alternative follows the first jump:
+      //
+      std::ptrdiff_t pos = (last_paren_start < 0) ? 0 : last_paren_start;
+      while(pos < first_jump)
+      {
+         re_syntax_base* state = this->getaddress(pos);
+         if((state->type == syntax_element_alt) && (pos + static_cast<re_alt*>(state)->alt.i == first_jump + re_jump_size))
+         {
+            this->factor_alternatives(pos, count);
+            break;
+         }
+         if(state->next.i == 0)
+            break;
+         pos += state->next.i;
+      }
    }
    return true;
 }
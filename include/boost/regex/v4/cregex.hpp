@@ -224,6 +224,7 @@ class RegEx;
 namespace BOOST_REGEX_DETAIL_NS{
 
 class RegExData;
+class RegExMatchData;
 struct pred1;
 struct pred2;
 struct pred3;
@@ -241,6 +242,30 @@ typedef bool (*GrepFileCallback)(const char* file, const RegEx& expression);
 typedef bool (*FindFilesCallback)(const char* file);
 #endif
 
+/*
+ * The results of a match found through the const members of RegEx,
+ * these refer to the text searched, which must outlive them:
+ */
+class BOOST_REGEX_DECL RegExMatch
+{
+private:
+   BOOST_REGEX_DETAIL_NS::RegExMatchData* pdata;
+public:
+   RegExMatch();
+   RegExMatch(const RegExMatch& o);
+   ~RegExMatch();
+   RegExMatch& operator=(const RegExMatch& o);
+
+   std::size_t Position(int i = 0)const;
+   std::size_t Length(int i = 0)const;
+   bool Matched(int i = 0)const;
+   std::size_t Marks()const;
+   std::string What(int i = 0)const;
+   std::string operator[](int i)const { return What(i); }
+
+   friend class RegEx;
+};
+
 class BOOST_REGEX_DECL RegEx
 {
 private:
@@ -265,6 +290,14 @@ public:
    bool Match(const std::string& s, match_flag_type flags = match_default) { return Match(s.c_str(), flags); }
    bool Search(const char* p, match_flag_type flags = match_default);
    bool Search(const std::string& s, match_flag_type flags = match_default) { return Search(s.c_str(), flags); }
+   /*
+    * these leave the results in what rather than in *this, so may be
+    * called on the same object from several threads at once:
+    */
+   bool Match(const char* p, RegExMatch& what, match_flag_type flags = match_default)const;
+   bool Match(const std::string& s, RegExMatch& what, match_flag_type flags = match_default)const { return Match(s.c_str(), what, flags); }
+   bool Search(const char* p, RegExMatch& what, match_flag_type flags = match_default)const;
+   bool Search(const std::string& s, RegExMatch& what, match_flag_type flags = match_default)const { return Search(s.c_str(), what, flags); }
    unsigned int Grep(GrepCallback cb, const char* p, match_flag_type flags = match_default);
    unsigned int Grep(GrepCallback cb, const std::string& s, match_flag_type flags = match_default) { return Grep(cb, s.c_str(), flags); }
    unsigned int Grep(std::vector<std::string>& v, const char* p, match_flag_type flags = match_default);
@@ -279,11 +312,11 @@ public:
 #endif
 
    std::string Merge(const std::string& in, const std::string& fmt,
-                       bool copy = true, match_flag_type flags = match_default);
+                       bool copy = true, match_flag_type flags = match_default)const;
    std::string Merge(const char* in, const char* fmt,
-                       bool copy = true, match_flag_type flags = match_default);
+                       bool copy = true, match_flag_type flags = match_default)const;
 
-   std::size_t Split(std::vector<std::string>& v, std::string& s, match_flag_type flags = match_default, unsigned max_count = ~0);
+   std::size_t Split(std::vector<std::string>& v, std::string& s, match_flag_type flags = match_default, unsigned max_count = ~0)const;
    /*
     * now operators for returning what matched in more detail:
     */
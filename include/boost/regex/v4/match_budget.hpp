@@ -0,0 +1,259 @@
+/*
+ *
+ * Copyright (c) 2016
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         match_budget.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares class match_budget, which limits the work done
+  *                by a single call to regex_search or regex_match, and
+  *                match_statistics which records it.
+  */
+
+#ifndef BOOST_REGEX_V4_MATCH_BUDGET_HPP
+#define BOOST_REGEX_V4_MATCH_BUDGET_HPP
+
+#include <ctime>
+#include <cstddef>
+#include <boost/cstdint.hpp>
+
+namespace boost{
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+//
+// Filled in by the matcher when attached to a match_budget,
+// describes how a single call went about its work:
+//
+struct match_statistics
+{
+   BOOST_STATIC_CONSTANT(unsigned, backtrack_types = 19);
+
+   // states of the expression visited:
+   boost::uintmax_t states;
+   // positions at which a match was attempted:
+   boost::uintmax_t attempts;
+   // characters from where the search began to where it ended:
+   boost::uintmax_t searched;
+   // entries popped off the backtracking stack, by type, see backtrack_name:
+   boost::uintmax_t backtracks[backtrack_types];
+   // most blocks of backtracking stack in use at once, and how often another was needed:
+   unsigned stack_blocks;
+   unsigned stack_extensions;
+   // most bytes of backtracking stack in use at once:
+   std::size_t stack_size;
+   // how candidate start positions were found, one of regbase::restart_*:
+   int restart_type;
+   // true if the bit-parallel search for short fixed length expressions was used:
+   bool used_shift_or;
+   // true if match_memoize was in effect:
+   bool memoized;
+   // true if the library was built with BOOST_REGEX_RECURSIVE, in which case
+   // there is no backtracking stack and the figures for it are zero:
+   bool recursive;
+
+   match_statistics()
+   { clear(); }
+   void clear()
+   {
+      states = attempts = searched = 0;
+      for(unsigned i = 0; i < backtrack_types; ++i)
+         backtracks[i] = 0;
+      stack_blocks = stack_extensions = 0;
+      stack_size = 0;
+      restart_type = 0;
+      used_shift_or = memoized = recursive = false;
+   }
+   static const char* backtrack_name(unsigned i)
+   {
+      static const char* const names[backtrack_types] = 
+      {
+         "end", "paren", "recursion_stopper", "assertion", "alt", "repeater_count", 
+         "extra_block", "greedy_single_repeat", "slow_dot_repeat", "fast_dot_repeat", 
+         "char_repeat", "short_set_repeat", "long_set_repeat", "non_greedy_repeat", 
+         "recursion", "recursion_pop", "commit", "then", "memo",
+      };
+      return i < backtrack_types ? names[i] : "";
+   }
+};
+
+class match_budget
+{
+public:
+   enum status_type
+   {
+      budget_ok = 0,
+      budget_states_exhausted = 1,
+      budget_time_exhausted = 2,
+      budget_cancelled = 3,
+      budget_stack_exhausted = 4
+   };
+   typedef bool (*callback_type)(void*);
+
+   match_budget()
+      : m_max_states(0), m_max_clock(0), m_max_stack(0), m_cancel(0), m_callback(0), m_callback_data(0),
+        m_interval(default_interval), m_stats(0), m_states(0), m_start(0), m_status(budget_ok) {}
+   explicit match_budget(boost::uintmax_t max_states)
+      : m_max_states(max_states), m_max_clock(0), m_max_stack(0), m_cancel(0), m_callback(0), m_callback_data(0),
+        m_interval(default_interval), m_stats(0), m_states(0), m_start(0), m_status(budget_ok) {}
+
+   // the most states the matcher may visit, zero for no limit:
+   void set_max_states(boost::uintmax_t n)
+   { m_max_states = n; }
+   // the most processor time, as measured by std::clock(), zero for no limit:
+   void set_max_clock(std::clock_t ticks)
+   { m_max_clock = ticks; }
+   // the most memory in bytes the backtracking stack may use, zero for 
+   // the library's default limit, see BOOST_REGEX_MAX_BLOCKS:
+   void set_max_stack(std::size_t bytes)
+   { m_max_stack = bytes; }
+   std::size_t max_stack()const
+   { return m_max_stack; }
+   // the search is abandoned once *flag becomes true:
+   void set_cancel_flag(const volatile bool* flag)
+   { m_cancel = flag; }
+   // the search is abandoned once f(data) returns false:
+   void set_callback(callback_type f, void* data)
+   { m_callback = f; m_callback_data = data; }
+   // how many states are visited between checks of the limits above:
+   void set_check_interval(unsigned n)
+   { m_interval = n ? n : 1; }
+   unsigned check_interval()const
+   { return m_interval; }
+   // where to record statistics for each call, null for none:
+   void set_statistics(match_statistics* s)
+   { m_stats = s; }
+   match_statistics* statistics()const
+   { return m_stats; }
+
+   // the outcome of the last call:
+   status_type status()const
+   { return m_status; }
+   bool exhausted()const
+   { return m_status != budget_ok; }
+   boost::uintmax_t states_used()const
+   { return m_states; }
+
+   //
+   // These are called by the matcher: begin at the start of each call,
+   // charge each time another check_interval() states have been visited,
+   // and end with the remainder, charge returns false once the search 
+   // should be abandoned, and stack_exhausted is called when the search
+   // is abandoned for want of stack:
+   //
+   void begin()
+   {
+      m_states = 0;
+      m_status = budget_ok;
+      if(m_max_clock)
+         m_start = std::clock();
+      if(m_stats)
+         m_stats->clear();
+   }
+   void end(boost::uintmax_t states)
+   {
+      m_states += states;
+      if(m_stats)
+         m_stats->states = m_states;
+   }
+   void stack_exhausted()
+   { m_status = budget_stack_exhausted; }
+   bool charge(boost::uintmax_t states)
+   {
+      m_states += states;
+      if(m_max_states && (m_states > m_max_states))
+         m_status = budget_states_exhausted;
+      else if(m_cancel && *m_cancel)
+         m_status = budget_cancelled;
+      else if(m_max_clock && (std::clock() - m_start > m_max_clock))
+         m_status = budget_time_exhausted;
+      else if(m_callback && !m_callback(m_callback_data))
+         m_status = budget_cancelled;
+      return m_status == budget_ok;
+   }
+
+private:
+   BOOST_STATIC_CONSTANT(unsigned, default_interval = 1024);
+
+   boost::uintmax_t m_max_states;
+   std::clock_t m_max_clock;
+   std::size_t m_max_stack;
+   const volatile bool* m_cancel;
+   callback_type m_callback;
+   void* m_callback_data;
+   unsigned m_interval;
+   match_statistics* m_stats;
+   boost::uintmax_t m_states;
+   std::clock_t m_start;
+   status_type m_status;
+};
+
+namespace BOOST_REGEX_DETAIL_NS{
+
+//
+// Thrown by the matcher when a match_budget runs out, and caught again
+// before returning to the caller, this unwinds the matcher's state
+// in the same way as any other error:
+//
+struct match_budget_exhausted {};
+
+template <class Matcher>
+bool call_within_budget(Matcher& m, bool (Matcher::*proc)(), match_budget& b)
+{
+   b.begin();
+   m.set_budget(&b);
+#ifndef BOOST_NO_EXCEPTIONS
+   try{
+#endif
+      bool result = (m.*proc)();
+      m.set_budget(0);
+      return result;
+#ifndef BOOST_NO_EXCEPTIONS
+   }
+   catch(const match_budget_exhausted&)
+   {
+      m.set_budget(0);
+      return false;
+   }
+   catch(...)
+   {
+      // the statistics are most interesting when something has gone wrong:
+      m.set_budget(0);
+      throw;
+   }
+#endif
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // namespace boost
+
+#endif
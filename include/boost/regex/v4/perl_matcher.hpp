@@ -76,6 +76,73 @@ inline bool can_start(unsigned int c, const unsigned char* map, unsigned char ma
 }
 #endif
 
+//
+// function find_literal_start:
+// returns the first position in [first, last) that is equal to c,
+// narrow character pointers can use memchr for this:
+//
+template <class iterator, class charT>
+inline iterator find_literal_start(iterator first, iterator last, charT c)
+{
+   while((first != last) && (*first != c))
+      ++first;
+   return first;
+}
+inline const char* find_literal_start(const char* first, const char* last, char c)
+{
+   const void* p = std::memchr(first, static_cast<unsigned char>(c), last - first);
+   return p ? static_cast<const char*>(p) : last;
+}
+
+//
+// function find_line_separator:
+// returns the first position in [first, last) that is a line separator,
+// narrow characters in contiguous storage are examined a word at a time:
+//
+inline const char* find_line_separator(const char* first, const char* last)
+{
+   typedef std::size_t word_type;
+   const word_type ones = ~static_cast<word_type>(0) / static_cast<unsigned char>(~0u);
+   const word_type highs = ones << (CHAR_BIT - 1);
+   while(last - first >= static_cast<std::ptrdiff_t>(sizeof(word_type)))
+   {
+      word_type w;
+      std::memcpy(&w, first, sizeof(w));
+      // a character of x is zero where w has a '\n', and of y where w has
+      // a '\r' or a '\f', which differ only in their lowest bit:
+      word_type x = w ^ (ones * '\n');
+      word_type y = (w | ones) ^ (ones * '\r');
+      if((((x - ones) & ~x) | ((y - ones) & ~y)) & highs)
+         break;
+      first += sizeof(word_type);
+   }
+   while((first != last) && !is_separator(*first))
+      ++first;
+   return first;
+}
+template <class iterator>
+inline iterator find_line_separator(iterator first, iterator last, const mpl::false_&)
+{
+   while((first != last) && !is_separator(*first))
+      ++first;
+   return first;
+}
+template <class iterator>
+inline iterator find_line_separator(iterator first, iterator last, const mpl::true_&)
+{
+   if(first == last)
+      return last;
+   const char* p = &*first;
+   return first + (find_line_separator(p, p + (last - first)) - p);
+}
+template <class iterator>
+inline iterator find_line_separator(iterator first, iterator last)
+{
+   typedef typename regex_iterator_traits<iterator>::value_type char_type;
+   typedef mpl::bool_< ::boost::is_same<char_type, char>::value && is_contiguous_iterator<iterator>::value> tag_type;
+   return find_line_separator(first, last, tag_type());
+}
+
 
 //
 // Unfortunately Rogue Waves standard library appears to have a bug
@@ -344,12 +411,37 @@ struct recursion_info
 {
    typedef typename Results::value_type value_type;
    typedef typename value_type::iterator iterator;
+   recursion_info()
+      : idx(0), preturn_address(0), results(), repeater_stack(0) {}
+   explicit recursion_info(const typename Results::allocator_type& a)
+      : idx(0), preturn_address(0), results(a), repeater_stack(0) {}
    int idx;
    const re_syntax_base* preturn_address;
    Results results;
    repeater_count<iterator>* repeater_stack;
 };
 
+//
+// Storage needed while matching comes from the same allocator as
+// the match_results being filled in, so that a user supplied allocator
+// sees every allocation made while matching:
+//
+template <class Results, class T>
+struct results_vector
+{
+#ifndef BOOST_NO_STD_ALLOCATOR
+   typedef typename Results::allocator_type base_allocator;
+#ifndef BOOST_NO_CXX11_ALLOCATOR
+   typedef typename std::allocator_traits<base_allocator>::template rebind_alloc<T> allocator_type;
+#else
+   typedef typename base_allocator::template rebind<T>::other allocator_type;
+#endif
+   typedef std::vector<T, allocator_type> type;
+#else
+   typedef std::vector<T> type;
+#endif
+};
+
 #ifdef BOOST_MSVC
 #pragma warning(push)
 #pragma warning(disable : 4251 4231)
@@ -375,23 +467,42 @@ public:
       const basic_regex<char_type, traits>& e,
       match_flag_type f,
       BidiIterator l_base)
-      :  m_result(what), base(first), last(end), 
+      :  m_result(what), m_temp_match(what.get_allocator()), base(first), last(end), 
          position(first), backstop(l_base), re(e), traits_inst(e.get_traits()), 
          m_independent(false), next_count(&rep_obj), rep_obj(&next_count)
+#ifndef BOOST_NO_STD_ALLOCATOR
+         , recursion_stack(what.get_allocator()), m_memo(what.get_allocator())
+#endif
    {
       construct_init(e, f);
    }
+#ifdef BOOST_REGEX_NON_RECURSIVE
+   ~perl_matcher()
+   {
+      if(m_stack_block)
+         put_mem_block(m_stack_block);
+   }
+#endif
 
    bool match();
    bool find();
+   // re-targets the matcher at [first, end) with new flags, so that one
+   // matcher can be reused for a sequence of searches:
+   void reset(BidiIterator first, match_flag_type f);
+   // limits, and records, the work done by subsequent calls to match() 
+   // or find(), see call_within_budget:
+   void set_budget(match_budget* b);
 
    void setf(match_flag_type f)
-   { m_match_flags |= f; }
+   { m_match_flags |= f; update_memoize(); }
    void unsetf(match_flag_type f)
-   { m_match_flags &= ~f; }
+   { m_match_flags &= ~f; update_memoize(); }
 
 private:
    void construct_init(const basic_regex<char_type, traits>& e, match_flag_type f);
+   void init_flags(match_flag_type f);
+   bool can_memoize()const;
+   void update_memoize();
 
    bool find_imp();
    bool match_imp();
@@ -401,10 +512,14 @@ private:
 #endif
    void estimate_max_state_count(std::random_access_iterator_tag*);
    void estimate_max_state_count(void*);
+   void reset_state_count();
+   void state_limit_reached();
+   void record_statistics();
    bool match_prefix();
    bool match_all_states();
+   bool match_state();
 
-   // match procs, stored in s_match_vtable:
+   // match procs, dispatched by match_state and match_all_states:
    bool match_startmark();
    bool match_endmark();
    bool match_literal();
@@ -438,6 +553,19 @@ private:
    }
    bool match_backstep();
    bool match_assert_backref();
+   // translates c as traits_inst.translate(c, ic) would, but with a table lookup
+   // for narrow characters when ic is true:
+   char_type translate(char_type c, bool ic)const
+   {
+      if(ic && m_case_fold)
+         return static_cast<char_type>(m_case_fold[static_cast<unsigned char>(c)]);
+      return traits_inst.translate(c, ic);
+   }
+   // failure memoization for match_memoize:
+   std::size_t memo_bit(int repeat_id, BidiIterator pos);
+   bool memo_failed(const re_repeat* rep);
+   void memo_set_failed(int repeat_id, BidiIterator pos);
+   void memo_clear();
    bool match_toggle_case();
 #ifdef BOOST_REGEX_RECURSIVE
    bool backtrack_till_match(std::size_t count);
@@ -455,12 +583,14 @@ private:
    bool find_restart_line();
    bool find_restart_buf();
    bool find_restart_lit();
+   // bit-parallel search for short fixed length expressions:
+   bool find_shift_or();
 
 private:
    // final result structure to be filled in:
    match_results<BidiIterator, Allocator>& m_result;
    // temporary result for POSIX matches:
-   scoped_ptr<match_results<BidiIterator, Allocator> > m_temp_match;
+   match_results<BidiIterator, Allocator> m_temp_match;
    // pointer to actual result structure to fill in:
    match_results<BidiIterator, Allocator>* m_presult;
    // start of sequence being searched:
@@ -485,10 +615,21 @@ private:
    match_flag_type m_match_flags;
    // how many states we have examined so far:
    std::ptrdiff_t state_count;
-   // max number of states to examine before giving up:
+   // max number of states to examine before giving up, or before
+   // next checking m_budget if there is one:
    std::ptrdiff_t max_state_count;
+   // user supplied limits, if any:
+   match_budget* m_budget;
+   // when there is a budget, the real value of max_state_count:
+   std::ptrdiff_t m_state_limit;
+   // the value of state_count when m_budget was last charged:
+   std::ptrdiff_t m_states_charged;
+   // m_budget->statistics(), if there is a budget:
+   match_statistics* m_stats;
    // whether we should ignore case or not:
    bool icase;
+   // re.get_data().m_case_fold->m_map, or null if there is no case folding table:
+   const unsigned char* m_case_fold;
    // set to true when (position == last), indicates that we may have a partial match:
    bool m_has_partial_match;
    // set to true whenever we get a match:
@@ -504,7 +645,17 @@ private:
    // the bitmask to use when determining whether a match_any matches a newline or not:
    unsigned char match_any_mask;
    // recursion information:
-   std::vector<recursion_info<results_type> > recursion_stack;
+   typename results_vector<results_type, recursion_info<results_type> >::type recursion_stack;
+   // set when match_memoize is in effect, or the text is short enough to memoize anyway:
+   bool m_memoize;
+   // bitmap of the (repeat, position) pairs known to fail, one row of 
+   // re.get_data().m_memo_repeats bits for each position in [backstop, last],
+   // points either to m_memo or, for short texts, to m_memo_small, null until first used:
+   unsigned char* m_memo_bits;
+   typename results_vector<results_type, unsigned char>::type m_memo;
+   unsigned char m_memo_small[BOOST_REGEX_AUTO_MEMOIZE_LIMIT / CHAR_BIT + 1];
+   // the range of positions recorded in m_memo since it was last cleared:
+   std::size_t m_memo_low, m_memo_high;
 #ifdef BOOST_REGEX_RECURSIVE
    // Set to false by a (*COMMIT):
    bool m_can_backtrack;
@@ -537,6 +688,7 @@ private:
    bool unwind_recursion_pop(bool);
    bool unwind_commit(bool);
    bool unwind_then(bool);
+   bool unwind_memo(bool);
    void destroy_single_repeat();
    void push_matched_paren(int index, const sub_match<BidiIterator>& sub);
    void push_recursion_stopper();
@@ -547,13 +699,18 @@ private:
    void push_non_greedy_repeat(const re_syntax_base* ps);
    void push_recursion(int idx, const re_syntax_base* p, results_type* presults);
    void push_recursion_pop();
+   void push_memo(int repeat_id);
 
+   // memory for the first block of the stack, kept until we're destroyed
+   // so that it can be reused by successive searches:
+   void* m_stack_block;
    // pointer to base of stack:
    saved_state* m_stack_base;
    // pointer to current stack position:
    saved_state* m_backup_state;
-   // how many memory blocks have we used up?:
-   unsigned used_block_count;
+   // how many memory blocks, and bytes, of stack are in use?:
+   unsigned m_stack_blocks;
+   std::size_t m_stack_size;
    // determines what value to return when unwinding from recursion,
    // allows for mixed recursive/non-recursive algorithm:
    bool m_recursive_result;
@@ -572,7 +729,12 @@ private:
       return *this;
    }
    perl_matcher(const perl_matcher& that)
-      : m_result(that.m_result), re(that.re), traits_inst(that.traits_inst), rep_obj(0) {}
+      : m_result(that.m_result), m_temp_match(that.m_result.get_allocator()), re(that.re), traits_inst(that.traits_inst), rep_obj(0)
+   {
+#ifdef BOOST_REGEX_NON_RECURSIVE
+      m_stack_block = 0;
+#endif
+   }
 };
 
 #ifdef BOOST_MSVC
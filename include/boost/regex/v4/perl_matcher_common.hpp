@@ -46,7 +46,6 @@ template <class BidiIterator, class Allocator, class traits>
 void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_regex<char_type, traits>& e, match_flag_type f)
 { 
    typedef typename regex_iterator_traits<BidiIterator>::iterator_category category;
-   typedef typename basic_regex<char_type, traits>::flag_type expression_flag_type;
    
    if(e.empty())
    {
@@ -55,10 +54,30 @@ void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_r
       boost::throw_exception(ex);
    }
    pstate = 0;
-   m_match_flags = f;
+#ifdef BOOST_REGEX_NON_RECURSIVE
+   m_stack_block = 0;
+#endif
+   icase = re.flags() & regex_constants::icase;
+   m_case_fold = re.get_data().m_case_fold ? re.get_data().m_case_fold->m_map : 0;
+   // find the value to use for matching word boundaries:
+   m_word_mask = re.get_data().m_word_mask; 
+   m_memo_bits = 0;
+   m_memo_low = (std::numeric_limits<std::size_t>::max)();
+   m_memo_high = 0;
+   m_budget = 0;
+   m_stats = 0;
+   init_flags(f);
+   m_memoize = can_memoize();
    estimate_max_state_count(static_cast<category*>(0));
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::init_flags(match_flag_type f)
+{ 
+   typedef typename basic_regex<char_type, traits>::flag_type expression_flag_type;
+
+   m_match_flags = f;
    expression_flag_type re_f = re.flags();
-   icase = re_f & regex_constants::icase;
    if(!(m_match_flags & (match_perl|match_posix)))
    {
       if((re_f & (regbase::main_option_type|regbase::no_perl_ex)) == 0)
@@ -71,10 +90,7 @@ void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_r
          m_match_flags |= match_posix;
    }
    if(m_match_flags & match_posix)
-   {
-      m_temp_match.reset(new match_results<BidiIterator, Allocator>());
-      m_presult = m_temp_match.get();
-   }
+      m_presult = &m_temp_match;
    else
       m_presult = &m_result;
 #ifdef BOOST_REGEX_NON_RECURSIVE
@@ -84,15 +100,196 @@ void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_r
    m_can_backtrack = true;
    m_have_accept = false;
 #endif
-   // find the value to use for matching word boundaries:
-   m_word_mask = re.get_data().m_word_mask; 
    // find bitmask to use for matching '.':
    match_any_mask = static_cast<unsigned char>((f & match_not_dot_newline) ? BOOST_REGEX_DETAIL_NS::test_not_newline : BOOST_REGEX_DETAIL_NS::test_newline);
    // Disable match_any if requested in the state machine:
-   if(e.get_data().m_disable_match_any)
+   if(re.get_data().m_disable_match_any)
       m_match_flags &= ~regex_constants::match_any;
 }
 
+template <class BidiIterator, class Allocator, class traits>
+bool perl_matcher<BidiIterator, Allocator, traits>::can_memoize()const
+{
+   // Failures can only be recorded by position when nothing but the position
+   // decides the outcome, and we need random access to turn positions into indexes.
+   // Expressions which may backtrack excessively are always memoized when the text 
+   // is short: then the bitmap fits in m_memo_small and the time taken is bounded
+   // by a polynomial in the length of the text, for little more than the cost
+   // of clearing the bitmap:
+   bool memoize = (m_match_flags & match_memoize) != 0;
+   if(!memoize && re.get_data().m_backtracking_hazard && re.get_data().m_memo_repeats 
+      && ::boost::is_random_access_iterator<BidiIterator>::value)
+   {
+      std::size_t positions = 1 + ::boost::BOOST_REGEX_DETAIL_NS::distance(backstop, last);
+      memoize = (positions <= BOOST_REGEX_AUTO_MEMOIZE_LIMIT / re.size())
+         && (positions * re.get_data().m_memo_repeats <= BOOST_REGEX_AUTO_MEMOIZE_LIMIT);
+   }
+   return memoize
+      && re.get_data().m_memo_repeats 
+      && ((m_match_flags & (match_posix | match_not_null | match_partial)) == 0)
+      && ::boost::is_random_access_iterator<BidiIterator>::value;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::update_memoize()
+{
+   typedef typename regex_iterator_traits<BidiIterator>::iterator_category category;
+   //
+   // New flags may turn memoization on or off, and the state count
+   // limit depends on which, so recalculate it when they do:
+   //
+   bool memoize = can_memoize();
+   if(memoize != m_memoize)
+   {
+      m_memoize = memoize;
+      estimate_max_state_count(static_cast<category*>(0));
+   }
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::reset(BidiIterator first, match_flag_type f)
+{
+   // The state count limit calculated for the original sequence is kept:
+   // [first, last) is normally the unsearched remainder of that sequence.
+   base = position = first;
+   pstate = 0;
+   init_flags(f);
+   update_memoize();
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::set_budget(match_budget* b)
+{
+   if(m_budget)
+   {
+      max_state_count = m_state_limit;
+      m_budget->end(state_count - m_states_charged);
+      if(m_stats)
+         record_statistics();
+   }
+   m_budget = b;
+   m_stats = b ? b->statistics() : 0;
+   if(m_budget)
+   {
+      m_state_limit = max_state_count;
+      reset_state_count();
+   }
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::record_statistics()
+{
+   // The counts are kept up to date while matching, this fills in the rest:
+   m_stats->searched = ::boost::BOOST_REGEX_DETAIL_NS::distance(search_base, position);
+   m_stats->memoized = m_memoize;
+#ifdef BOOST_REGEX_RECURSIVE
+   m_stats->recursive = true;
+#else
+   if(m_stats->stack_blocks == 0)
+   {
+      m_stats->stack_blocks = 1;
+      m_stats->stack_size = BOOST_REGEX_BLOCKSIZE;
+   }
+#endif
+}
+
+template <class BidiIterator, class Allocator, class traits>
+inline void perl_matcher<BidiIterator, Allocator, traits>::reset_state_count()
+{
+   state_count = 0;
+   if(m_budget)
+   {
+      // check the budget every check_interval() states, and let 
+      // state_limit_reached() take care of the real limit:
+      m_states_charged = 0;
+      max_state_count = (std::min)(m_state_limit, static_cast<std::ptrdiff_t>(m_budget->check_interval()));
+   }
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::state_limit_reached()
+{
+   if(m_budget)
+   {
+      std::ptrdiff_t states = state_count - m_states_charged;
+      m_states_charged = state_count;
+      if(!m_budget->charge(states))
+      {
+#ifndef BOOST_NO_EXCEPTIONS
+         throw match_budget_exhausted();
+#else
+         raise_error(traits_inst, regex_constants::error_complexity);
+#endif
+      }
+      if(state_count <= m_state_limit)
+      {
+         std::ptrdiff_t interval = m_budget->check_interval();
+         max_state_count = (m_state_limit - state_count > interval) ? state_count + interval : m_state_limit;
+         return;
+      }
+   }
+   raise_error(traits_inst, regex_constants::error_complexity);
+}
+
+template <class BidiIterator, class Allocator, class traits>
+inline std::size_t perl_matcher<BidiIterator, Allocator, traits>::memo_bit(int repeat_id, BidiIterator pos)
+{
+   return static_cast<std::size_t>(::boost::BOOST_REGEX_DETAIL_NS::distance(pos, last)) * re.get_data().m_memo_repeats + repeat_id;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+inline bool perl_matcher<BidiIterator, Allocator, traits>::memo_failed(const re_repeat* rep)
+{
+   if(!m_memo_bits)
+      return false;
+   std::size_t bit = memo_bit(rep->state_id, position);
+   return (m_memo_bits[bit / CHAR_BIT] & (1u << (bit % CHAR_BIT))) != 0;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::memo_set_failed(int repeat_id, BidiIterator pos)
+{
+   if(!m_memo_bits)
+   {
+      std::size_t positions = 1 + ::boost::BOOST_REGEX_DETAIL_NS::distance(backstop, last);
+      std::size_t bytes = (positions * re.get_data().m_memo_repeats + CHAR_BIT - 1) / CHAR_BIT;
+      if(bytes <= sizeof(m_memo_small))
+      {
+         std::fill(m_memo_small, m_memo_small + bytes, static_cast<unsigned char>(0));
+         m_memo_bits = m_memo_small;
+      }
+      else
+      {
+         m_memo.assign(bytes, static_cast<unsigned char>(0));
+         m_memo_bits = &m_memo[0];
+      }
+   }
+   std::size_t column = ::boost::BOOST_REGEX_DETAIL_NS::distance(pos, last);
+   m_memo_low = (std::min)(m_memo_low, column);
+   m_memo_high = (std::max)(m_memo_high, column);
+   std::size_t bit = memo_bit(repeat_id, pos);
+   m_memo_bits[bit / CHAR_BIT] |= static_cast<unsigned char>(1u << (bit % CHAR_BIT));
+}
+
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::memo_clear()
+{
+   //
+   // Only clear the positions we've recorded something for, so that a
+   // sequence of searches with the same matcher doesn't cost time 
+   // proportional to the length of the whole text for each search:
+   //
+   if(m_memo_low <= m_memo_high)
+   {
+      std::size_t rows = re.get_data().m_memo_repeats;
+      std::fill(m_memo_bits + (m_memo_low * rows) / CHAR_BIT, 
+         m_memo_bits + ((m_memo_high + 1) * rows + CHAR_BIT - 1) / CHAR_BIT, 
+         static_cast<unsigned char>(0));
+      m_memo_low = (std::numeric_limits<std::size_t>::max)();
+      m_memo_high = 0;
+   }
+}
+
 template <class BidiIterator, class Allocator, class traits>
 void perl_matcher<BidiIterator, Allocator, traits>::estimate_max_state_count(std::random_access_iterator_tag*)
 {
@@ -139,6 +336,20 @@ void perl_matcher<BidiIterator, Allocator, traits>::estimate_max_state_count(std
       return;
    }
    states *= dist;
+   if(m_memoize)
+   {
+      //
+      // When memoizing, each repeat is explored at most once from each position,
+      // with at most O(NS) work on the way to the next repeat, so allow O(N^2S):
+      //
+      std::ptrdiff_t len = re.size() ? re.size() : 1;
+      if((std::numeric_limits<std::ptrdiff_t>::max)() / len < states)
+      {
+         max_state_count = (std::min)((std::ptrdiff_t)BOOST_REGEX_MAX_STATE_COUNT, (std::numeric_limits<std::ptrdiff_t>::max)() - 2);
+         return;
+      }
+      states *= len;
+   }
    if((std::numeric_limits<std::ptrdiff_t>::max)() - k < states)
    {
       max_state_count = (std::min)((std::ptrdiff_t)BOOST_REGEX_MAX_STATE_COUNT, (std::numeric_limits<std::ptrdiff_t>::max)() - 2);
@@ -194,8 +405,9 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_imp()
 {
    // initialise our stack if we are non-recursive:
 #ifdef BOOST_REGEX_NON_RECURSIVE
-   save_state_init init(&m_stack_base, &m_backup_state);
-   used_block_count = BOOST_REGEX_MAX_BLOCKS;
+   save_state_init init(&m_stack_base, &m_backup_state, &m_stack_block);
+   m_stack_blocks = 1;
+   m_stack_size = BOOST_REGEX_BLOCKSIZE;
 #if !defined(BOOST_NO_EXCEPTIONS)
    try{
 #endif
@@ -204,7 +416,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_imp()
    // reset our state machine:
    position = base;
    search_base = base;
-   state_count = 0;
+   reset_state_count();
+   memo_clear();
    m_match_flags |= regex_constants::match_all;
    m_presult->set_size((m_match_flags & match_nosubs) ? 1 : 1 + re.mark_count(), search_base, last);
    m_presult->set_base(base);
@@ -212,6 +425,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_imp()
    if(m_match_flags & match_posix)
       m_result = *m_presult;
    verify_options(re.flags(), m_match_flags);
+   if(m_stats)
+      m_stats->restart_type = regbase::restart_continue;
    if(0 == match_prefix())
       return false;
    return (m_result[0].second == last) && (m_result[0].first == base);
@@ -255,14 +470,17 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
 
    // initialise our stack if we are non-recursive:
 #ifdef BOOST_REGEX_NON_RECURSIVE
-   save_state_init init(&m_stack_base, &m_backup_state);
-   used_block_count = BOOST_REGEX_MAX_BLOCKS;
+   save_state_init init(&m_stack_base, &m_backup_state, &m_stack_block);
+   m_stack_blocks = 1;
+   m_stack_size = BOOST_REGEX_BLOCKSIZE;
 #if !defined(BOOST_NO_EXCEPTIONS)
    try{
 #endif
 #endif
 
-   state_count = 0;
+   reset_state_count();
+   // anything recorded may depend on where the last search started:
+   memo_clear();
    if((m_match_flags & regex_constants::match_init) == 0)
    {
       // reset our state machine:
@@ -293,7 +511,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
    }
    if(m_match_flags & match_posix)
    {
-      m_result.set_size(1 + re.mark_count(), base, last);
+      m_result.set_size((m_match_flags & match_nosubs) ? 1 : 1 + re.mark_count(), base, last);
       m_result.set_base(base);
    }
 
@@ -303,6 +521,19 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
       static_cast<unsigned int>(regbase::restart_continue) 
          : static_cast<unsigned int>(re.get_restart_type());
 
+   if(m_stats)
+      m_stats->restart_type = type;
+   // short fixed length expressions can be found in a single pass, 
+   // as long as the match flags don't alter what they can match:
+   if((type == regbase::restart_any) && re.get_data().m_shift_or
+      && ((m_match_flags & (match_partial | match_extra)) == 0)
+      && !(re.get_data().m_shift_or->m_has_wild && (m_match_flags & match_not_dot_null))
+      && !(re.get_data().m_shift_or->m_has_newline_wild && (m_match_flags & match_not_dot_newline)))
+   {
+      if(m_stats)
+         m_stats->used_shift_or = true;
+      return find_shift_or();
+   }
    // call the appropriate search routine:
    matcher_proc_type proc = s_find_vtable[type];
    return (this->*proc)();
@@ -328,6 +559,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_prefix()
    pstate = re.get_first_state();
    m_presult->set_first(position);
    restart = position;
+   if(m_stats)
+      ++m_stats->attempts;
    match_all_states();
    if(!m_has_found_match && m_has_partial_match && (m_match_flags & match_partial))
    {
@@ -360,6 +593,90 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_prefix()
    return m_has_found_match;
 }
 
+template <class BidiIterator, class Allocator, class traits>
+inline bool perl_matcher<BidiIterator, Allocator, traits>::match_state()
+{
+   //
+   // Dispatch the current state to its handler: using a switch rather than
+   // a table of member function pointers lets the compiler inline the
+   // common cases, and replaces an indirect call with a jump table:
+   //
+   switch(pstate->type)
+   {
+   case syntax_element_startmark:
+      return match_startmark();
+   case syntax_element_endmark:
+      return match_endmark();
+   case syntax_element_literal:
+      return match_literal();
+   case syntax_element_start_line:
+      return match_start_line();
+   case syntax_element_end_line:
+      return match_end_line();
+   case syntax_element_wild:
+      return match_wild();
+   case syntax_element_match:
+      return match_match();
+   case syntax_element_word_boundary:
+      return match_word_boundary();
+   case syntax_element_within_word:
+      return match_within_word();
+   case syntax_element_word_start:
+      return match_word_start();
+   case syntax_element_word_end:
+      return match_word_end();
+   case syntax_element_buffer_start:
+      return match_buffer_start();
+   case syntax_element_buffer_end:
+      return match_buffer_end();
+   case syntax_element_backref:
+      return match_backref();
+   case syntax_element_long_set:
+      return match_long_set();
+   case syntax_element_set:
+      return match_set();
+   case syntax_element_jump:
+      return match_jump();
+   case syntax_element_alt:
+      return match_alt();
+   case syntax_element_rep:
+      return match_rep();
+   case syntax_element_combining:
+      return match_combining();
+   case syntax_element_soft_buffer_end:
+      return match_soft_buffer_end();
+   case syntax_element_restart_continue:
+      return match_restart_continue();
+   case syntax_element_dot_rep:
+      return match_dot_repeat_dispatch();
+   case syntax_element_char_rep:
+      return match_char_repeat();
+   case syntax_element_short_set_rep:
+      return match_set_repeat();
+   case syntax_element_long_set_rep:
+      return match_long_set_repeat();
+   case syntax_element_backstep:
+      return match_backstep();
+   case syntax_element_assert_backref:
+      return match_assert_backref();
+   case syntax_element_toggle_case:
+      return match_toggle_case();
+   case syntax_element_recurse:
+      return match_recursion();
+   case syntax_element_fail:
+      return match_fail();
+   case syntax_element_accept:
+      return match_accept();
+   case syntax_element_commit:
+      return match_commit();
+   case syntax_element_then:
+      return match_then();
+   default:
+      BOOST_ASSERT(0);
+   }
+   return false;
+}
+
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_literal()
 {
@@ -370,7 +687,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_literal()
    // our records:
    for(unsigned int i = 0; i < len; ++i, ++position)
    {
-      if((position == last) || (traits_inst.translate(*position, icase) != what[i]))
+      if((position == last) || (translate(*position, icase) != what[i]))
          return false;
    }
    pstate = pstate->next.p;
@@ -618,7 +935,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_backref()
    BidiIterator j = (*m_presult)[index].second;
    while(i != j)
    {
-      if((position == last) || (traits_inst.translate(*position, icase) != traits_inst.translate(*i, icase)))
+      if((position == last) || (translate(*position, icase) != translate(*i, icase)))
          return false;
       ++i;
       ++position;
@@ -649,7 +966,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set()
 {
    if(position == last)
       return false;
-   if(static_cast<const re_set*>(pstate)->_map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+   if(static_cast<const re_set*>(pstate)->_map[static_cast<unsigned char>(translate(*position, icase))])
    {
       pstate = pstate->next.p;
       ++position;
@@ -670,10 +987,10 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_combining()
 {
    if(position == last)
       return false;
-   if(is_combining(traits_inst.translate(*position, icase)))
+   if(is_combining(translate(*position, icase)))
       return false;
    ++position;
-   while((position != last) && is_combining(traits_inst.translate(*position, icase)))
+   while((position != last) && is_combining(translate(*position, icase)))
       ++position;
    pstate = pstate->next.p;
    return true;
@@ -685,7 +1002,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_soft_buffer_end()
    if(m_match_flags & match_not_eob)
       return false;
    BidiIterator p(position);
-   while((p != last) && is_separator(traits_inst.translate(*p, icase)))++p;
+   while((p != last) && is_separator(translate(*p, icase)))++p;
    if(p != last)
       return false;
    pstate = pstate->next.p;
@@ -900,8 +1217,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_line()
       return true;
    while(position != last)
    {
-      while((position != last) && !is_separator(*position))
-         ++position;
+      position = find_line_separator(position, last);
       if(position == last)
          return false;
       ++position;
@@ -935,62 +1251,77 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_buf()
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_lit()
 {
-#if 0
-   if(position == last)
-      return false; // can't possibly match if we're at the end already
-
-   unsigned type = (m_match_flags & match_continuous) ? 
-      static_cast<unsigned int>(regbase::restart_continue) 
-         : static_cast<unsigned int>(re.get_restart_type());
+   // do search optimised for expressions that are a single literal string:
+   const re_syntax_base* state = re.get_first_state();
+   bool l_icase = icase;
+   while((state->type == syntax_element_startmark) || (state->type == syntax_element_endmark))
+   {
+      l_icase = static_cast<const re_brace*>(state)->icase;
+      state = state->next.p;
+   }
+   BOOST_ASSERT(state->type == syntax_element_literal);
+   const char_type first_char = *reinterpret_cast<const char_type*>(static_cast<const re_literal*>(state) + 1);
+   while(position != last)
+   {
+      // skip everything that can't start the literal:
+      if(l_icase || (sizeof(char_type) != 1))
+      {
+         while((position != last) && (translate(*position, l_icase) != first_char))
+            ++position;
+      }
+      else
+         position = find_literal_start(position, last, first_char);
+      if(position == last)
+         break;
+      // now try and obtain a match:
+      if(match_prefix())
+         return true;
+      if(position == last)
+         return false;
+      ++position;
+   }
+   return false;
+}
 
-   const kmp_info<char_type>* info = access::get_kmp(re);
-   int len = info->len;
-   const char_type* x = info->pstr;
-   int j = 0; 
-   while (position != last) 
+template <class BidiIterator, class Allocator, class traits>
+bool perl_matcher<BidiIterator, Allocator, traits>::find_shift_or()
+{
+   //
+   // Every match of the expression has the same length, so the leftmost
+   // match is the one that ends first, and that's what we look for here: 
+   // bit i of l_state is clear if the last i+1 characters match the first 
+   // i+1 positions of the expression:
+   //
+   typedef re_shift_or::mask_type mask_type;
+   const re_shift_or& so = *re.get_data().m_shift_or;
+   const mask_type match_bit = static_cast<mask_type>(1u) << (so.m_length - 1);
+   mask_type l_state = ~static_cast<mask_type>(0);
+   while(position != last)
    {
-      while((j > -1) && (x[j] != traits_inst.translate(*position, icase))) 
-         j = info->kmp_next[j];
+      l_state = (l_state << 1) | so.m_masks[static_cast<unsigned char>(*position)];
       ++position;
-      ++j;
-      if(j >= len) 
+      if((l_state & match_bit) == 0)
       {
-         if(type == regbase::restart_fixed_lit)
+         BidiIterator start(position);
+         std::advance(start, -static_cast<difference_type>(so.m_length));
+         m_presult->set_first(start);
+         if(m_presult->size() > 1)
          {
-            std::advance(position, -j);
-            restart = position;
-            std::advance(restart, len);
-            m_result.set_first(position);
-            m_result.set_second(restart);
-            position = restart;
-            return true;
-         }
-         else
-         {
-            restart = position;
-            std::advance(position, -j);
-            if(match_prefix())
-               return true;
-            else
+            for(std::vector<re_shift_or::group>::const_iterator i = so.m_groups.begin(); i != so.m_groups.end(); ++i)
             {
-               for(int k = 0; (restart != position) && (k < j); ++k, --restart)
-                     {} // dwa 10/20/2000 - warning suppression for MWCW
-               if(restart != last)
-                  ++restart;
-               position = restart;
-               j = 0;  //we could do better than this...
+               BidiIterator pos(start);
+               std::advance(pos, static_cast<difference_type>(i->first));
+               m_presult->set_first(pos, i->index);
+               std::advance(pos, static_cast<difference_type>(i->second - i->first));
+               m_presult->set_second(pos, i->index);
             }
          }
+         m_presult->set_second(position);
+         if((m_match_flags & match_posix) == match_posix)
+            m_result.maybe_assign(*m_presult);
+         return true;
       }
    }
-   if((m_match_flags & match_partial) && (position == last) && j)
-   {
-      // we need to check for a partial match:
-      restart = position;
-      std::advance(position, -j);
-      return match_prefix();
-   }
-#endif
    return false;
 }
 
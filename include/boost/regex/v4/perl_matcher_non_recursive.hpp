@@ -94,17 +94,21 @@ struct saved_repeater : public saved_state
 struct saved_extra_block : public saved_state
 {
    saved_state *base, *end;
-   saved_extra_block(saved_state* b, saved_state* e) 
-      : saved_state(saved_state_extra_block), base(b), end(e) {}
+   std::size_t size;  // of the block holding this entry
+   saved_extra_block(saved_state* b, saved_state* e, std::size_t s) 
+      : saved_state(saved_state_extra_block), base(b), end(e), size(s) {}
 };
 
 struct save_state_init
 {
    saved_state** stack;
-   save_state_init(saved_state** base, saved_state** end)
+   save_state_init(saved_state** base, saved_state** end, void** block)
       : stack(base)
    {
-      *base = static_cast<saved_state*>(get_mem_block());
+      // the first block is owned by the matcher, and is reused by each search:
+      if(*block == 0)
+         *block = get_mem_block();
+      *base = static_cast<saved_state*>(*block);
       *end = reinterpret_cast<saved_state*>(reinterpret_cast<char*>(*base)+BOOST_REGEX_BLOCKSIZE);
       --(*end);
       (void) new (*end)saved_state(0);
@@ -112,7 +116,6 @@ struct save_state_init
    }
    ~save_state_init()
    {
-      put_mem_block(*stack);
       *stack = 0;
    }
 };
@@ -127,6 +130,15 @@ struct saved_single_repeat : public saved_state
       : saved_state(arg_id), count(c), rep(r), last_position(lp){}
 };
 
+template <class BidiIterator>
+struct saved_memo : public saved_state
+{
+   saved_memo(int id, BidiIterator p) 
+      : saved_state(18), repeat_id(id), position(p){}
+   int repeat_id;
+   BidiIterator position;
+};
+
 template <class Results>
 struct saved_recursion : public saved_state
 {
@@ -138,61 +150,181 @@ struct saved_recursion : public saved_state
    Results results;
 };
 
+#ifdef BOOST_REGEX_HAS_COMPUTED_GOTO
+//
+// Labels as values are a GNU extension:
+//
+#  if defined(__GNUC__) && !defined(__clang__)
+#     pragma GCC diagnostic push
+#     pragma GCC diagnostic ignored "-Wpedantic"
+#  elif defined(__clang__)
+#     pragma clang diagnostic push
+#     pragma clang diagnostic ignored "-Wgnu-label-as-value"
+#  endif
+#endif
+
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_all_states()
 {
-   static matcher_proc_type const s_match_vtable[34] = 
-   {
-      (&perl_matcher<BidiIterator, Allocator, traits>::match_startmark),
-      &perl_matcher<BidiIterator, Allocator, traits>::match_endmark,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_literal,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_start_line,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_end_line,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_wild,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_match,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_word_boundary,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_within_word,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_word_start,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_word_end,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_buffer_start,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_buffer_end,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_backref,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_long_set,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_set,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_jump,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_alt,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_rep,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_combining,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_soft_buffer_end,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_restart_continue,
-      // Although this next line *should* be evaluated at compile time, in practice
-      // some compilers (VC++) emit run-time initialisation which breaks thread
-      // safety, so use a dispatch function instead:
-      //(::boost::is_random_access_iterator<BidiIterator>::value ? &perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_fast : &perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_slow),
-      &perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_dispatch,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_backstep,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_assert_backref,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_toggle_case,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_recursion,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_fail,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_accept,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_commit,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_then,
+#ifdef BOOST_REGEX_HAS_COMPUTED_GOTO
+   //
+   // Each handler jumps directly to the handler for the next state, so
+   // that every state transition has its own indirect branch for the CPU
+   // to predict, rather than all of them sharing the one in a loop:
+   //
+   static void* const s_match_labels[34] = 
+   {
+      &&l_startmark,
+      &&l_endmark,
+      &&l_literal,
+      &&l_start_line,
+      &&l_end_line,
+      &&l_wild,
+      &&l_match,
+      &&l_word_boundary,
+      &&l_within_word,
+      &&l_word_start,
+      &&l_word_end,
+      &&l_buffer_start,
+      &&l_buffer_end,
+      &&l_backref,
+      &&l_long_set,
+      &&l_set,
+      &&l_jump,
+      &&l_alt,
+      &&l_rep,
+      &&l_combining,
+      &&l_soft_buffer_end,
+      &&l_restart_continue,
+      &&l_dot_rep,
+      &&l_char_rep,
+      &&l_short_set_rep,
+      &&l_long_set_rep,
+      &&l_backstep,
+      &&l_assert_backref,
+      &&l_toggle_case,
+      &&l_recurse,
+      &&l_fail,
+      &&l_accept,
+      &&l_commit,
+      &&l_then
    };
+   bool successful_unwind;
+
+#define BOOST_REGEX_DISPATCH_STATE(proc)\
+   if(!proc())\
+      goto l_state_failed;\
+   if(!pstate)\
+      goto l_states_done;\
+   ++state_count;\
+   goto *s_match_labels[pstate->type];
+
+   push_recursion_stopper();
+l_next_state:
+   if(!pstate)
+      goto l_states_done;
+   ++state_count;
+   goto *s_match_labels[pstate->type];
+
+l_startmark:
+   BOOST_REGEX_DISPATCH_STATE(match_startmark)
+l_endmark:
+   BOOST_REGEX_DISPATCH_STATE(match_endmark)
+l_literal:
+   BOOST_REGEX_DISPATCH_STATE(match_literal)
+l_start_line:
+   BOOST_REGEX_DISPATCH_STATE(match_start_line)
+l_end_line:
+   BOOST_REGEX_DISPATCH_STATE(match_end_line)
+l_wild:
+   BOOST_REGEX_DISPATCH_STATE(match_wild)
+l_match:
+   BOOST_REGEX_DISPATCH_STATE(match_match)
+l_word_boundary:
+   BOOST_REGEX_DISPATCH_STATE(match_word_boundary)
+l_within_word:
+   BOOST_REGEX_DISPATCH_STATE(match_within_word)
+l_word_start:
+   BOOST_REGEX_DISPATCH_STATE(match_word_start)
+l_word_end:
+   BOOST_REGEX_DISPATCH_STATE(match_word_end)
+l_buffer_start:
+   BOOST_REGEX_DISPATCH_STATE(match_buffer_start)
+l_buffer_end:
+   BOOST_REGEX_DISPATCH_STATE(match_buffer_end)
+l_backref:
+   BOOST_REGEX_DISPATCH_STATE(match_backref)
+l_long_set:
+   BOOST_REGEX_DISPATCH_STATE(match_long_set)
+l_set:
+   BOOST_REGEX_DISPATCH_STATE(match_set)
+l_jump:
+   BOOST_REGEX_DISPATCH_STATE(match_jump)
+l_alt:
+   BOOST_REGEX_DISPATCH_STATE(match_alt)
+l_rep:
+   BOOST_REGEX_DISPATCH_STATE(match_rep)
+l_combining:
+   BOOST_REGEX_DISPATCH_STATE(match_combining)
+l_soft_buffer_end:
+   BOOST_REGEX_DISPATCH_STATE(match_soft_buffer_end)
+l_restart_continue:
+   BOOST_REGEX_DISPATCH_STATE(match_restart_continue)
+l_dot_rep:
+   BOOST_REGEX_DISPATCH_STATE(match_dot_repeat_dispatch)
+l_char_rep:
+   BOOST_REGEX_DISPATCH_STATE(match_char_repeat)
+l_short_set_rep:
+   BOOST_REGEX_DISPATCH_STATE(match_set_repeat)
+l_long_set_rep:
+   BOOST_REGEX_DISPATCH_STATE(match_long_set_repeat)
+l_backstep:
+   BOOST_REGEX_DISPATCH_STATE(match_backstep)
+l_assert_backref:
+   BOOST_REGEX_DISPATCH_STATE(match_assert_backref)
+l_toggle_case:
+   BOOST_REGEX_DISPATCH_STATE(match_toggle_case)
+l_recurse:
+   BOOST_REGEX_DISPATCH_STATE(match_recursion)
+l_fail:
+   BOOST_REGEX_DISPATCH_STATE(match_fail)
+l_accept:
+   BOOST_REGEX_DISPATCH_STATE(match_accept)
+l_commit:
+   BOOST_REGEX_DISPATCH_STATE(match_commit)
+l_then:
+   BOOST_REGEX_DISPATCH_STATE(match_then)
+
+l_state_failed:
+   if(state_count > max_state_count)
+      state_limit_reached();
+   if((m_match_flags & match_partial) && (position == last) && (position != search_base))
+      m_has_partial_match = true;
+   successful_unwind = unwind(false);
+   if((m_match_flags & match_partial) && (position == last) && (position != search_base))
+      m_has_partial_match = true;
+   if(false == successful_unwind)
+      return m_recursive_result;
+   goto l_next_state;
+
+l_states_done:
+   if(state_count > max_state_count)
+      state_limit_reached();
+   if(unwind(true))
+      goto l_next_state;
+   return m_recursive_result;
 
+#undef BOOST_REGEX_DISPATCH_STATE
+#else
    push_recursion_stopper();
    do{
       while(pstate)
       {
-         matcher_proc_type proc = s_match_vtable[pstate->type];
          ++state_count;
-         if(!(this->*proc)())
+         if(!match_state())
          {
             if(state_count > max_state_count)
-               raise_error(traits_inst, regex_constants::error_complexity);
+               state_limit_reached();
             if((m_match_flags & match_partial) && (position == last) && (position != search_base))
                m_has_partial_match = true;
             bool successful_unwind = unwind(false);
@@ -202,28 +334,76 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_all_states()
                return m_recursive_result;
          }
       }
+      if(state_count > max_state_count)
+         state_limit_reached();
    }while(unwind(true));
    return m_recursive_result;
+#endif
 }
 
+#ifdef BOOST_REGEX_HAS_COMPUTED_GOTO
+#  if defined(__GNUC__) && !defined(__clang__)
+#     pragma GCC diagnostic pop
+#  elif defined(__clang__)
+#     pragma clang diagnostic pop
+#  endif
+#endif
+
 template <class BidiIterator, class Allocator, class traits>
 void perl_matcher<BidiIterator, Allocator, traits>::extend_stack()
 {
-   if(used_block_count)
-   {
-      --used_block_count;
-      saved_state* stack_base;
-      saved_state* backup_state;
-      stack_base = static_cast<saved_state*>(get_mem_block());
-      backup_state = reinterpret_cast<saved_state*>(reinterpret_cast<char*>(stack_base)+BOOST_REGEX_BLOCKSIZE);
-      saved_extra_block* block = static_cast<saved_extra_block*>(backup_state);
-      --block;
-      (void) new (block) saved_extra_block(m_stack_base, m_backup_state);
-      m_stack_base = stack_base;
-      m_backup_state = block;
-   }
-   else
+   //
+   // The first few blocks are BOOST_REGEX_BLOCKSIZE bytes and come from the block
+   // cache, after that each new block is as large as all those before it, up to 
+   // 256 times BOOST_REGEX_BLOCKSIZE, so that a very deep stack needs few allocations.
+   // The total may not exceed the budget's max_stack(), or by default 
+   // BOOST_REGEX_MAX_BLOCKS times BOOST_REGEX_BLOCKSIZE:
+   //
+   std::size_t limit = (m_budget && m_budget->max_stack()) ? m_budget->max_stack() 
+      : static_cast<std::size_t>(BOOST_REGEX_MAX_BLOCKS) * BOOST_REGEX_BLOCKSIZE;
+   if((m_stack_size >= limit) || (limit - m_stack_size < BOOST_REGEX_BLOCKSIZE))
+   {
+      if(m_budget && m_budget->max_stack())
+      {
+         m_budget->stack_exhausted();
+#ifndef BOOST_NO_EXCEPTIONS
+         throw match_budget_exhausted();
+#endif
+      }
       raise_error(traits_inst, regex_constants::error_stack);
+   }
+   //
+   // The limit above is on depth alone, so a search which keeps growing and
+   // shrinking the stack is stopped by charging each extension one state per
+   // block in use (stepping through such a search costs time in proportion to
+   // the depth), and checking the state count here, since it may never fail a state:
+   //
+   state_count += static_cast<std::ptrdiff_t>(m_stack_size / BOOST_REGEX_BLOCKSIZE);
+   if(state_count > max_state_count)
+      state_limit_reached();
+   std::size_t size = BOOST_REGEX_BLOCKSIZE;
+   if(m_stack_blocks >= BOOST_REGEX_MAX_CACHE_BLOCKS)
+   {
+      size = (std::min)((std::min)(m_stack_size, static_cast<std::size_t>(BOOST_REGEX_BLOCKSIZE) * 256), limit - m_stack_size);
+      size -= size % BOOST_REGEX_BLOCKSIZE;
+   }
+   saved_state* stack_base = static_cast<saved_state*>(size == BOOST_REGEX_BLOCKSIZE ? get_mem_block() : ::operator new(size));
+   m_stack_size += size;
+   ++m_stack_blocks;
+   if(m_stats)
+   {
+      ++m_stats->stack_extensions;
+      if(m_stack_blocks > m_stats->stack_blocks)
+         m_stats->stack_blocks = m_stack_blocks;
+      if(m_stack_size > m_stats->stack_size)
+         m_stats->stack_size = m_stack_size;
+   }
+   saved_state* backup_state = reinterpret_cast<saved_state*>(reinterpret_cast<char*>(stack_base)+size);
+   saved_extra_block* block = static_cast<saved_extra_block*>(backup_state);
+   --block;
+   (void) new (block) saved_extra_block(m_stack_base, m_backup_state, size);
+   m_stack_base = stack_base;
+   m_backup_state = block;
 }
 
 template <class BidiIterator, class Allocator, class traits>
@@ -347,6 +527,21 @@ inline void perl_matcher<BidiIterator, Allocator, traits>::push_recursion(int id
    m_backup_state = pmp;
 }
 
+template <class BidiIterator, class Allocator, class traits>
+inline void perl_matcher<BidiIterator, Allocator, traits>::push_memo(int repeat_id)
+{
+   saved_memo<BidiIterator>* pmp = static_cast<saved_memo<BidiIterator>*>(m_backup_state);
+   --pmp;
+   if(pmp < m_stack_base)
+   {
+      extend_stack();
+      pmp = static_cast<saved_memo<BidiIterator>*>(m_backup_state);
+      --pmp;
+   }
+   (void) new (pmp)saved_memo<BidiIterator>(repeat_id, position);
+   m_backup_state = pmp;
+}
+
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_startmark()
 {
@@ -555,6 +750,15 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_rep()
       return false;
    }
 
+   if(m_memoize && rep->memoize && (next_count->get_count() < rep->max))
+   {
+      // If we've failed from here before then we'll fail again, otherwise 
+      // leave a note on the stack to record the failure if we do:
+      if(memo_failed(rep))
+         return false;
+      push_memo(rep->state_id);
+   }
+
    bool greedy = (rep->greedy) && (!(m_match_flags & regex_constants::match_any) || m_independent);   
    if(greedy)
    {
@@ -611,7 +815,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_rep()
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_slow()
 {
-   unsigned count = 0;
+   std::size_t count = 0;
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
    re_syntax_base* psingle = rep->next.p;
    // match compulsary repeats first:
@@ -663,7 +867,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_fast()
 
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
    bool greedy = (rep->greedy) && (!(m_match_flags & regex_constants::match_any) || m_independent);   
-   unsigned count = static_cast<unsigned>((std::min)(static_cast<unsigned>(::boost::BOOST_REGEX_DETAIL_NS::distance(position, last)), static_cast<unsigned>(greedy ? rep->max : rep->min)));
+   std::size_t count = (std::min)(static_cast<std::size_t>(::boost::BOOST_REGEX_DETAIL_NS::distance(position, last)), greedy ? rep->max : rep->min);
    if(rep->min > count)
    {
       position = last;
@@ -722,15 +926,15 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
       else
          std::advance(end, desired);
       BidiIterator origin(position);
-      while((position != end) && (traits_inst.translate(*position, icase) == what))
+      while((position != end) && (translate(*position, icase) == what))
       {
          ++position;
       }
-      count = (unsigned)::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position);
+      count = static_cast<std::size_t>(::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position));
    }
    else
    {
-      while((count < desired) && (position != last) && (traits_inst.translate(*position, icase) == what))
+      while((count < desired) && (position != last) && (translate(*position, icase) == what))
       {
          ++position;
          ++count;
@@ -744,8 +948,11 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
    {
       if((rep->leading) && (count < rep->max))
          restart = position;
-      // push backtrack info if available:
-      if(count - rep->min)
+      // push backtrack info if available, a possessive repeat is just charged 
+      // for the states that backtracking would have visited:
+      if(rep->possessive)
+         state_count += static_cast<std::ptrdiff_t>(count - rep->min);
+      else if(count - rep->min)
          push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
       // jump to next state:
       pstate = rep->alt.p;
@@ -796,15 +1003,15 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
       else
          std::advance(end, desired);
       BidiIterator origin(position);
-      while((position != end) && map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+      while((position != end) && map[static_cast<unsigned char>(translate(*position, icase))])
       {
          ++position;
       }
-      count = (unsigned)::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position);
+      count = static_cast<std::size_t>(::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position));
    }
    else
    {
-      while((count < desired) && (position != last) && map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+      while((count < desired) && (position != last) && map[static_cast<unsigned char>(translate(*position, icase))])
       {
          ++position;
          ++count;
@@ -818,8 +1025,11 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
    {
       if((rep->leading) && (count < rep->max))
          restart = position;
-      // push backtrack info if available:
-      if(count - rep->min)
+      // push backtrack info if available, a possessive repeat is just charged 
+      // for the states that backtracking would have visited:
+      if(rep->possessive)
+         state_count += static_cast<std::ptrdiff_t>(count - rep->min);
+      else if(count - rep->min)
          push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
       // jump to next state:
       pstate = rep->alt.p;
@@ -875,7 +1085,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat()
       {
          ++position;
       }
-      count = (unsigned)::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position);
+      count = static_cast<std::size_t>(::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position));
    }
    else
    {
@@ -893,8 +1103,11 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat()
    {
       if((rep->leading) && (count < rep->max))
          restart = position;
-      // push backtrack info if available:
-      if(count - rep->min)
+      // push backtrack info if available, a possessive repeat is just charged 
+      // for the states that backtracking would have visited:
+      if(rep->possessive)
+         state_count += static_cast<std::ptrdiff_t>(count - rep->min);
+      else if(count - rep->min)
          push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
       // jump to next state:
       pstate = rep->alt.p;
@@ -931,7 +1144,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_recursion()
    {
       recursion_stack.reserve(50);
    }
-   recursion_stack.push_back(recursion_info<results_type>());
+   recursion_stack.push_back(recursion_info<results_type>(m_result.get_allocator()));
    recursion_stack.back().preturn_address = pstate->next.p;
    recursion_stack.back().results = *m_presult;
    pstate = static_cast<const re_jump*>(pstate)->alt.p;
@@ -1142,7 +1355,10 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind(bool have_match)
       &perl_matcher<BidiIterator, Allocator, traits>::unwind_recursion_pop,
       &perl_matcher<BidiIterator, Allocator, traits>::unwind_commit,
       &perl_matcher<BidiIterator, Allocator, traits>::unwind_then,
+      &perl_matcher<BidiIterator, Allocator, traits>::unwind_memo,
    };
+   // match_statistics keeps one count for each entry:
+   BOOST_STATIC_ASSERT(sizeof(s_unwind_table) / sizeof(s_unwind_table[0]) == match_statistics::backtrack_types);
 
    m_recursive_result = have_match;
    m_unwound_lookahead = false;
@@ -1154,6 +1370,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind(bool have_match)
    //
    do
    {
+      if(m_stats)
+         ++m_stats->backtracks[m_backup_state->state_id];
       unwinder = s_unwind_table[m_backup_state->state_id];
       cont = (this->*unwinder)(m_recursive_result);
    }while(cont);
@@ -1244,10 +1462,29 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_extra_block(bool)
 {
    saved_extra_block* pmp = static_cast<saved_extra_block*>(m_backup_state);
    void* condemmed = m_stack_base;
+   std::size_t size = pmp->size;
    m_stack_base = pmp->base;
    m_backup_state = pmp->end;
    boost::BOOST_REGEX_DETAIL_NS::inplace_destroy(pmp);
-   put_mem_block(condemmed);
+   if(size == BOOST_REGEX_BLOCKSIZE)
+      put_mem_block(condemmed);
+   else
+      ::operator delete(condemmed);
+   // the limit is on how deep the stack gets, not on how often it changes size:
+   m_stack_size -= size;
+   --m_stack_blocks;
+   return true; // keep looking
+}
+
+template <class BidiIterator, class Allocator, class traits>
+bool perl_matcher<BidiIterator, Allocator, traits>::unwind_memo(bool r)
+{
+   saved_memo<BidiIterator>* pmp = static_cast<saved_memo<BidiIterator>*>(m_backup_state);
+   // every way forward from this repeat and position has now been tried:
+   if(!r)
+      memo_set_failed(pmp->repeat_id, pmp->position);
+   boost::BOOST_REGEX_DETAIL_NS::inplace_destroy(pmp++);
+   m_backup_state = pmp;
    return true; // keep looking
 }
 
@@ -1458,7 +1695,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_char_repeat(bool r)
       // wind forward until we can skip out of the repeat:
       do
       {
-         if(traits_inst.translate(*position, icase) != what)
+         if(translate(*position, icase) != what)
          {
             // failed repeat match, discard this state and look for another:
             destroy_single_repeat();
@@ -1527,7 +1764,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_short_set_repeat(bool
       // wind forward until we can skip out of the repeat:
       do
       {
-         if(!map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+         if(!map[static_cast<unsigned char>(translate(*position, icase))])
          {
             // failed repeat match, discard this state and look for another:
             destroy_single_repeat();
@@ -1658,7 +1895,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_recursion(bool r)
    saved_recursion<results_type>* pmp = static_cast<saved_recursion<results_type>*>(m_backup_state);
    if(!r)
    {
-      recursion_stack.push_back(recursion_info<results_type>());
+      recursion_stack.push_back(recursion_info<results_type>(m_result.get_allocator()));
       recursion_stack.back().idx = pmp->recursion_id;
       recursion_stack.back().preturn_address = pmp->preturn_address;
       recursion_stack.back().results = pmp->results;
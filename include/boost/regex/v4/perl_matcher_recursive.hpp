@@ -60,55 +60,12 @@ public:
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_all_states()
 {
-   static matcher_proc_type const s_match_vtable[34] = 
-   {
-      (&perl_matcher<BidiIterator, Allocator, traits>::match_startmark),
-      &perl_matcher<BidiIterator, Allocator, traits>::match_endmark,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_literal,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_start_line,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_end_line,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_wild,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_match,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_word_boundary,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_within_word,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_word_start,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_word_end,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_buffer_start,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_buffer_end,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_backref,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_long_set,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_set,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_jump,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_alt,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_rep,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_combining,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_soft_buffer_end,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_restart_continue,
-      // Although this next line *should* be evaluated at compile time, in practice
-      // some compilers (VC++) emit run-time initialisation which breaks thread
-      // safety, so use a dispatch function instead:
-      //(::boost::is_random_access_iterator<BidiIterator>::value ? &perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_fast : &perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_slow),
-      &perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_dispatch,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_backstep,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_assert_backref,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_toggle_case,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_recursion,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_fail,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_accept,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_commit,
-      &perl_matcher<BidiIterator, Allocator, traits>::match_then,
-   };
-
    if(state_count > max_state_count)
-      raise_error(traits_inst, regex_constants::error_complexity);
+      state_limit_reached();
    while(pstate)
    {
-      matcher_proc_type proc = s_match_vtable[pstate->type];
       ++state_count;
-      if(!(this->*proc)())
+      if(!match_state())
       {
          if((m_match_flags & match_partial) && (position == last) && (position != search_base))
             m_has_partial_match = true;
@@ -360,6 +317,15 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_rep()
       }
       return false;
    }
+   //
+   // When memoizing, if we've failed from here before then we'll fail again,
+   // otherwise we have to match the rest of the expression from here ourselves
+   // rather than leaving it to our caller, so that we know if it fails:
+   //
+   bool memoize = m_memoize && rep->memoize && (next_count->get_count() < rep->max);
+   if(memoize && memo_failed(rep))
+      return false;
+   BidiIterator start_position = position;
    bool greedy = (rep->greedy) && (!(m_match_flags & regex_constants::match_any) || m_independent);   
    if(greedy)
    {
@@ -381,9 +347,11 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_rep()
       if(take_second)
       {
          pstate = rep->alt.p;
-         return true;
+         if(!memoize)
+            return true;
+         if(match_all_states())
+            return true;
       }
-      return false; // can't take anything, fail...
    }
    else // non-greedy
    {
@@ -405,9 +373,14 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_rep()
          // increase the counter:
          ++(*next_count);
          pstate = rep->next.p;
-         return match_all_states();
+         if(!memoize)
+            return match_all_states();
+         if(match_all_states())
+            return true;
       }
    }
+   if(memoize)
+      memo_set_failed(rep->state_id, start_position);
    return false;
 #ifdef BOOST_MSVC
 #pragma warning(pop)
@@ -421,7 +394,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_slow()
 #pragma warning(push)
 #pragma warning(disable:4127)
 #endif
-   unsigned count = 0;
+   std::size_t count = 0;
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
    re_syntax_base* psingle = rep->next.p;
    // match compulsary repeats first:
@@ -454,7 +427,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_slow()
       BidiIterator save_pos;
       do
       {
-         if((rep->leading) && (rep->max == UINT_MAX))
+         if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
             restart = position;
          pstate = rep->alt.p;
          save_pos = position;
@@ -519,7 +492,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_fast()
          ++position;
          ++count;
       }
-      if((rep->leading) && (rep->max == UINT_MAX))
+      if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
          restart = position;
       pstate = rep->alt.p;
       save_pos = position;
@@ -585,7 +558,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
    {
       count = 0;
       desired = greedy ? rep->max : rep->min;
-      while((count < desired) && (position != last) && (traits_inst.translate(*position, icase) == what))
+      while((count < desired) && (position != last) && (translate(*position, icase) == what))
       {
          ++position;
          ++count;
@@ -605,7 +578,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
    {
       while((position != last) && (count < rep->max) && !can_start(*position, rep->_map, mask_skip))
       {
-         if((traits_inst.translate(*position, icase) == what))
+         if((translate(*position, icase) == what))
          {
             ++position;
             ++count;
@@ -613,7 +586,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
          else
             return false;  // counldn't repeat even though it was the only option
       }
-      if((rep->leading) && (rep->max == UINT_MAX))
+      if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
          restart = position;
       pstate = rep->alt.p;
       save_pos = position;
@@ -625,7 +598,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
       position = save_pos;
       if(position == last)
          return false;
-      if(traits_inst.translate(*position, icase) == what)
+      if(translate(*position, icase) == what)
       {
          ++position;
          ++count;
@@ -655,7 +628,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
 #endif
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
    const unsigned char* map = static_cast<const re_set*>(rep->next.p)->_map;
-   unsigned count = 0;
+   std::size_t count = 0;
    //
    // start by working out how much we can skip:
    //
@@ -672,15 +645,15 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
       else
          std::advance(end, desired);
       BidiIterator origin(position);
-      while((position != end) && map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+      while((position != end) && map[static_cast<unsigned char>(translate(*position, icase))])
       {
          ++position;
       }
-      count = (unsigned)::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position);
+      count = static_cast<std::size_t>(::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position));
    }
    else
    {
-      while((count < desired) && (position != last) && map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+      while((count < desired) && (position != last) && map[static_cast<unsigned char>(translate(*position, icase))])
       {
          ++position;
          ++count;
@@ -700,7 +673,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
    {
       while((position != last) && (count < rep->max) && !can_start(*position, rep->_map, mask_skip))
       {
-         if(map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+         if(map[static_cast<unsigned char>(translate(*position, icase))])
          {
             ++position;
             ++count;
@@ -708,7 +681,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
          else
             return false;  // counldn't repeat even though it was the only option
       }
-      if((rep->leading) && (rep->max == UINT_MAX))
+      if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
          restart = position;
       pstate = rep->alt.p;
       save_pos = position;
@@ -720,7 +693,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
       position = save_pos;
       if(position == last)
          return false;
-      if(map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+      if(map[static_cast<unsigned char>(translate(*position, icase))])
       {
          ++position;
          ++count;
@@ -751,7 +724,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat()
    typedef typename traits::char_class_type char_class_type;
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
    const re_set_long<char_class_type>* set = static_cast<const re_set_long<char_class_type>*>(pstate->next.p);
-   unsigned count = 0;
+   std::size_t count = 0;
    //
    // start by working out how much we can skip:
    //
@@ -772,7 +745,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat()
       {
          ++position;
       }
-      count = (unsigned)::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position);
+      count = static_cast<std::size_t>(::boost::BOOST_REGEX_DETAIL_NS::distance(origin, position));
    }
    else
    {
@@ -804,7 +777,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat()
          else
             return false;  // counldn't repeat even though it was the only option
       }
-      if((rep->leading) && (rep->max == UINT_MAX))
+      if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
          restart = position;
       pstate = rep->alt.p;
       save_pos = position;
@@ -848,6 +821,12 @@ bool perl_matcher<BidiIterator, Allocator, traits>::backtrack_till_match(std::si
 
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
    BidiIterator backtrack = position;
+   if(rep->possessive)
+   {
+      // backtracking can't succeed, but is charged for the states it would have visited:
+      state_count += static_cast<std::ptrdiff_t>(count);
+      count = 0;
+   }
    if(position == last)
    {
       if(rep->can_be_null & mask_skip) 
@@ -898,7 +877,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_recursion()
    {
       recursion_stack.reserve(50);
    }
-   recursion_stack.push_back(recursion_info<results_type>());
+   recursion_stack.push_back(recursion_info<results_type>(m_result.get_allocator()));
    recursion_stack.back().preturn_address = pstate->next.p;
    recursion_stack.back().results = *m_presult;
    recursion_stack.back().repeater_stack = next_count;
@@ -974,7 +953,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_match()
       recursion_stack.pop_back();
       if(!match_all_states())
       {
-         recursion_stack.push_back(recursion_info<results_type>());
+         recursion_stack.push_back(recursion_info<results_type>(m_result.get_allocator()));
          recursion_stack.back().preturn_address = saved_state;
          recursion_stack.back().results = *m_presult;
          return false;
@@ -86,7 +86,8 @@ public:
       nosubs = 1 << 22,                                 // don't mark sub-expressions
       save_subexpression_location = 1 << 23,            // save subexpression locations
       no_empty_expressions = 1 << 24,                   // no empty expressions allowed
-      optimize = 0,                                     // not really supported
+      optimize = 1 << 25,                               // spend more time optimising the state machine
+      no_backtracking_hazards = 1 << 26,                // reject expressions which may take exponential time to match
       
 
 
@@ -145,6 +146,7 @@ namespace regex_constants{
       no_mod_s = ::boost::regbase::no_mod_s,
       save_subexpression_location = ::boost::regbase::save_subexpression_location,
       no_empty_expressions = ::boost::regbase::no_empty_expressions,
+      no_backtracking_hazards = ::boost::regbase::no_backtracking_hazards,
 
       basic = ::boost::regbase::basic,
       extended = ::boost::regbase::extended,
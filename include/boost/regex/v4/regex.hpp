@@ -84,9 +84,15 @@
 #ifndef BOOST_REGEX_V4_PROTECTED_CALL_HPP
 #include <boost/regex/v4/protected_call.hpp>
 #endif
+#ifndef BOOST_REGEX_V4_MATCH_BUDGET_HPP
+#include <boost/regex/v4/match_budget.hpp>
+#endif
 #ifndef BOOST_REGEX_MATCHER_HPP
 #include <boost/regex/v4/perl_matcher.hpp>
 #endif
+#ifndef BOOST_REGEX_V4_REGEX_PROGRAM_HPP
+#include <boost/regex/v4/regex_program.hpp>
+#endif
 //
 // template instances:
 //
@@ -153,6 +159,12 @@ typedef match_results<std::wstring::const_iterator> wsmatch;
 #ifndef BOOST_REGEX_TOKEN_ITERATOR_HPP
 #include <boost/regex/v4/regex_token_iterator.hpp>
 #endif
+#ifndef BOOST_REGEX_V4_REGEX_COUNT_HPP
+#include <boost/regex/v4/regex_count.hpp>
+#endif
+#ifndef BOOST_REGEX_V4_REGEX_SET_HPP
+#include <boost/regex/v4/regex_set.hpp>
+#endif
 #ifndef BOOST_REGEX_V4_REGEX_GREP_HPP
 #include <boost/regex/v4/regex_grep.hpp>
 #endif
@@ -0,0 +1,132 @@
+/*
+ *
+ * Copyright (c) 1998-2002
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the 
+ * Boost Software License, Version 1.0. (See accompanying file 
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_count.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Provides regex_count implementation.
+  */
+
+#ifndef BOOST_REGEX_V4_REGEX_COUNT_HPP
+#define BOOST_REGEX_V4_REGEX_COUNT_HPP
+
+
+namespace boost{
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+//
+// regex_count:
+// returns the number of matches that a regex_iterator would enumerate
+// over the sequence first last, without recording any sub-expressions:
+//
+template <class BidiIterator, class charT, class traits>
+std::size_t regex_count(BidiIterator first, BidiIterator last, 
+                        const basic_regex<charT, traits>& e, 
+                        match_flag_type flags = match_default)
+{
+   if(e.flags() & regex_constants::failbit)
+      return 0;
+
+   typedef typename match_results<BidiIterator>::allocator_type match_allocator_type;
+
+   flags = BOOST_REGEX_DETAIL_NS::no_subs_flags(e, flags);
+   match_results<BidiIterator> what;
+   // one matcher is reset for each search, as regex_iterator does:
+   BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, match_allocator_type, traits> matcher(first, last, what, e, flags, first);
+   std::size_t count = 0;
+   while(matcher.find())
+   {
+      ++count;
+      // carry on from the end of this match exactly as regex_iterator does:
+      match_flag_type f(flags);
+      if(!what.length() || (f & regex_constants::match_posix))
+         f |= regex_constants::match_not_initial_null;
+      matcher.reset(what[0].second, f);
+   }
+   return count;
+}
+
+//
+// regex_count convenience interfaces:
+#ifndef BOOST_NO_FUNCTION_TEMPLATE_ORDERING
+template <class charT, class traits>
+inline std::size_t regex_count(const charT* str, 
+                               const basic_regex<charT, traits>& e, 
+                               match_flag_type flags = match_default)
+{
+   return regex_count(str, str + traits::length(str), e, flags);
+}
+
+template <class ST, class SA, class charT, class traits>
+inline std::size_t regex_count(const std::basic_string<charT, ST, SA>& s, 
+                               const basic_regex<charT, traits>& e, 
+                               match_flag_type flags = match_default)
+{
+   return regex_count(s.begin(), s.end(), e, flags);
+}
+#else  // non-template function overloads
+inline std::size_t regex_count(const char* str, 
+                               const regex& e, 
+                               match_flag_type flags = match_default)
+{
+   return regex_count(str, str + regex::traits_type::length(str), e, flags);
+}
+#ifndef BOOST_NO_WREGEX
+inline std::size_t regex_count(const wchar_t* str, 
+                               const wregex& e, 
+                               match_flag_type flags = match_default)
+{
+   return regex_count(str, str + wregex::traits_type::length(str), e, flags);
+}
+#endif
+inline std::size_t regex_count(const std::string& s, 
+                               const regex& e, 
+                               match_flag_type flags = match_default)
+{
+   return regex_count(s.begin(), s.end(), e, flags);
+}
+#if !defined(BOOST_NO_WREGEX)
+inline std::size_t regex_count(const std::basic_string<wchar_t>& s, 
+                               const wregex& e, 
+                               match_flag_type flags = match_default)
+{
+   return regex_count(s.begin(), s.end(), e, flags);
+}
+#endif
+
+#endif
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // namespace boost
+
+#endif  // BOOST_REGEX_V4_REGEX_COUNT_HPP
+
@@ -20,6 +20,8 @@
 #define BOOST_REGEX_V4_REGEX_ITERATOR_HPP
 
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/scoped_ptr.hpp>
 
 namespace boost{
 
@@ -40,20 +42,24 @@ template <class BidirectionalIterator,
 class regex_iterator_implementation 
 {
    typedef basic_regex<charT, traits> regex_type;
+   typedef BOOST_REGEX_DETAIL_NS::perl_matcher<BidirectionalIterator, typename match_results<BidirectionalIterator>::allocator_type, traits> matcher_type;
 
    match_results<BidirectionalIterator> what;  // current match
    BidirectionalIterator                base;  // start of sequence
    BidirectionalIterator                end;   // end of sequence
    const regex_type                     re;   // the expression
    match_flag_type                      flags; // flags for matching
+   scoped_ptr<matcher_type>             matcher; // reused for each search, created on demand
 
 public:
    regex_iterator_implementation(const regex_type* p, BidirectionalIterator last, match_flag_type f)
       : base(), end(last), re(*p), flags(f){}
+   regex_iterator_implementation(const regex_iterator_implementation& that)
+      : what(that.what), base(that.base), end(that.end), re(that.re), flags(that.flags){}
    bool init(BidirectionalIterator first)
    {
       base = first;
-      return regex_search(first, end, what, re, flags);
+      return search(first, flags);
    }
    bool compare(const regex_iterator_implementation& that)
    {
@@ -72,12 +78,22 @@ public:
          f |= regex_constants::match_not_initial_null;
       //if(base != next_start)
       //   f |= regex_constants::match_not_bob;
-      bool result = regex_search(next_start, end, what, re, f, base);
+      bool result = search(next_start, f);
       if(result)
          what.set_base(base);
       return result;
    }
 private:
+   bool search(BidirectionalIterator first, match_flag_type f)
+   {
+      if(re.flags() & regex_constants::failbit)
+         return false;
+      if(matcher.get())
+         matcher->reset(first, f);
+      else
+         matcher.reset(new matcher_type(first, end, what, re, f, base));
+      return matcher->find();
+   }
    regex_iterator_implementation& operator=(const regex_iterator_implementation&);
 };
 
@@ -110,7 +126,7 @@ public:
    regex_iterator(BidirectionalIterator a, BidirectionalIterator b, 
                   const regex_type& re, 
                   match_flag_type m = match_default)
-                  : pdata(new impl(&re, b, m))
+                  : pdata(boost::make_shared<impl>(&re, b, m))
    {
       if(!pdata->init(a))
       {
@@ -124,6 +140,15 @@ public:
       pdata = that.pdata;
       return *this;
    }
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+   regex_iterator(regex_iterator&& that)
+      : pdata(static_cast<pimpl&&>(that.pdata)) {}
+   regex_iterator& operator=(regex_iterator&& that)
+   {
+      pdata = static_cast<pimpl&&>(that.pdata);
+      return *this;
+   }
+#endif
    bool operator==(const regex_iterator& that)const
    { 
       if((pdata.get() == 0) || (that.pdata.get() == 0))
@@ -160,7 +185,7 @@ private:
       // copy-on-write
       if(pdata.get() && !pdata.unique())
       {
-         pdata.reset(new impl(*(pdata.get())));
+         pdata = boost::make_shared<impl>(*(pdata.get()));
       }
    }
 };
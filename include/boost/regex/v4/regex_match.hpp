@@ -58,6 +58,31 @@ bool regex_match(iterator first, iterator last,
    return regex_match(first, last, m, e, flags | regex_constants::match_any);
 }
 //
+// regex_match with a match_budget:
+// returns false without throwing once the budget is exhausted,
+// budget.status() then records why:
+//
+template <class BidiIterator, class Allocator, class charT, class traits>
+bool regex_match(BidiIterator first, BidiIterator last, 
+                 match_results<BidiIterator, Allocator>& m, 
+                 const basic_regex<charT, traits>& e, 
+                 match_budget& budget,
+                 match_flag_type flags = match_default)
+{
+   typedef BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, Allocator, traits> matcher_type;
+   matcher_type matcher(first, last, m, e, flags, first);
+   return BOOST_REGEX_DETAIL_NS::call_within_budget(matcher, &matcher_type::match, budget);
+}
+template <class iterator, class charT, class traits>
+bool regex_match(iterator first, iterator last, 
+                 const basic_regex<charT, traits>& e, 
+                 match_budget& budget,
+                 match_flag_type flags = match_default)
+{
+   match_results<iterator> m;
+   return regex_match(first, last, m, e, budget, flags | regex_constants::match_any);
+}
+//
 // query_match convenience interfaces:
 #ifndef BOOST_NO_FUNCTION_TEMPLATE_ORDERING
 //
@@ -99,6 +124,24 @@ inline bool regex_match(const std::basic_string<charT, ST, SA>& s,
    match_results<iterator> m;
    return regex_match(s.begin(), s.end(), m, e, flags | regex_constants::match_any);
 }
+
+template <class ST, class SA, class Allocator, class charT, class traits>
+inline bool regex_match(const std::basic_string<charT, ST, SA>& s, 
+                 match_results<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& m, 
+                 const basic_regex<charT, traits>& e, 
+                 match_budget& budget,
+                 match_flag_type flags = match_default)
+{
+   return regex_match(s.begin(), s.end(), m, e, budget, flags);
+}
+template <class ST, class SA, class charT, class traits>
+inline bool regex_match(const std::basic_string<charT, ST, SA>& s, 
+                 const basic_regex<charT, traits>& e, 
+                 match_budget& budget,
+                 match_flag_type flags = match_default)
+{
+   return regex_match(s.begin(), s.end(), e, budget, flags);
+}
 #else  // partial ordering
 inline bool regex_match(const char* str, 
                         cmatch& m, 
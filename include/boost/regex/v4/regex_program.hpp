@@ -0,0 +1,512 @@
+/*
+ *
+ * Copyright (c) 2016
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_program.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Provides print_regex_program, which describes the state
+  *                machine an expression was compiled to, as JSON or as a
+  *                Graphviz DOT graph.
+  */
+
+#ifndef BOOST_REGEX_V4_REGEX_PROGRAM_HPP
+#define BOOST_REGEX_V4_REGEX_PROGRAM_HPP
+
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+
+namespace boost{
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+enum regex_program_format
+{
+   regex_program_json,
+   regex_program_dot
+};
+
+namespace BOOST_REGEX_DETAIL_NS{
+
+//
+// The program is first described as a list of properties for the
+// expression as a whole, followed by a list of properties for each
+// state, each property has separate values for JSON and for DOT:
+//
+struct program_property
+{
+   program_property(const std::string& n, const std::string& j, const std::string& d)
+      : name(n), json(j), dot(d) {}
+   std::string name;
+   std::string json;
+   std::string dot;
+};
+
+struct program_node
+{
+   int id;
+   std::string type;
+   int next;
+   int alt;
+   std::vector<program_property> properties;
+};
+
+inline const char* syntax_element_name(int type)
+{
+   static const char* const names[] =
+   {
+      "startmark", "endmark", "literal", "start_line", "end_line", "wild", "match",
+      "word_boundary", "within_word", "word_start", "word_end", "buffer_start",
+      "buffer_end", "backref", "long_set", "set", "jump", "alt", "rep", "combining",
+      "soft_buffer_end", "restart_continue", "dot_rep", "char_rep", "short_set_rep",
+      "long_set_rep", "backstep", "assert_backref", "toggle_case", "recurse",
+      "fail", "accept", "commit", "then",
+   };
+   return (type >= 0) && (type < static_cast<int>(sizeof(names) / sizeof(names[0]))) ? names[type] : "unknown";
+}
+
+inline const char* restart_type_name(unsigned type)
+{
+   static const char* const names[regbase::restart_count] =
+   {
+      "any", "word", "line", "buf", "continue", "lit", "fixed_lit",
+   };
+   return type < regbase::restart_count ? names[type] : "unknown";
+}
+
+template <class charT>
+inline unsigned program_char_value(charT c)
+{
+   return sizeof(charT) == 1 ? static_cast<unsigned char>(c) : static_cast<unsigned>(c);
+}
+
+inline void append_program_char(std::string& s, unsigned c)
+{
+   static const char hex[] = "0123456789abcdef";
+   if((c >= 0x20) && (c < 0x7f) && (c != '\\') && (c != '-') && (c != '[') && (c != ']') && (c != '^'))
+      s.append(1, static_cast<char>(c));
+   else
+   {
+      s.append("\\x{");
+      bool digits = false;
+      for(int shift = 28; shift >= 0; shift -= 4)
+      {
+         unsigned d = (c >> shift) & 0xF;
+         if(d || digits || (shift == 0))
+         {
+            s.append(1, hex[d]);
+            digits = true;
+         }
+      }
+      s.append("}");
+   }
+}
+
+//
+// Describes which of the 256 entries of map have any of the bits in mask set,
+// as a character class:
+//
+inline std::string program_char_map(const unsigned char* map, unsigned mask)
+{
+   unsigned count = 0;
+   for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+      if(map[i] & mask)
+         ++count;
+   if(count == (1u << CHAR_BIT))
+      return "any";
+   std::string result("[");
+   for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+   {
+      if(map[i] & mask)
+      {
+         unsigned j = i;
+         while((j + 1 < (1u << CHAR_BIT)) && (map[j + 1] & mask))
+            ++j;
+         append_program_char(result, i);
+         if(j > i + 1)
+            result.append("-");
+         if(j > i)
+            append_program_char(result, j);
+         i = j;
+      }
+   }
+   result.append("]");
+   return result;
+}
+
+inline std::string program_escape(const std::string& s, regex_program_format f)
+{
+   std::string result;
+   for(std::string::size_type i = 0; i < s.size(); ++i)
+   {
+      unsigned char c = static_cast<unsigned char>(s[i]);
+      if((c == '"') || (c == '\\'))
+      {
+         result.append(1, '\\');
+         result.append(1, s[i]);
+      }
+      else if(c < 0x20)
+      {
+         static const char hex[] = "0123456789abcdef";
+         result.append(f == regex_program_json ? "\\u00" : "\\\\x");
+         result.append(1, hex[c >> 4]);
+         result.append(1, hex[c & 0xF]);
+      }
+      else
+         result.append(1, s[i]);
+   }
+   return result;
+}
+
+template <class charT, class traits>
+class regex_program_printer
+{
+public:
+   regex_program_printer(const basic_regex<charT, traits>& e)
+      : m_data(e.get_data()) {}
+   void print(std::ostream& os, regex_program_format f);
+private:
+   const regex_data<charT, traits>& m_data;
+   std::map<const re_syntax_base*, int> m_ids;
+   std::vector<program_property> m_properties;
+   std::vector<program_property> m_optimizations;
+   std::vector<program_node> m_nodes;
+
+   int id_of(const re_syntax_base* state)const
+   {
+      std::map<const re_syntax_base*, int>::const_iterator i = m_ids.find(state);
+      return i == m_ids.end() ? -1 : i->second;
+   }
+   template <class T>
+   static std::string to_string(const T& val)
+   {
+      std::ostringstream ss;
+      ss << val;
+      return ss.str();
+   }
+   static void add(std::vector<program_property>& v, const char* name, const std::string& s)
+   {
+      v.push_back(program_property(name, "\"" + program_escape(s, regex_program_json) + "\"", s));
+   }
+   static void add(std::vector<program_property>& v, const char* name, bool b)
+   {
+      v.push_back(program_property(name, b ? "true" : "false", b ? "true" : "false"));
+   }
+   static void add(std::vector<program_property>& v, const char* name, std::size_t n)
+   {
+      if(n == (std::numeric_limits<std::size_t>::max)())
+         v.push_back(program_property(name, "null", "inf"));
+      else
+         v.push_back(program_property(name, to_string(n), to_string(n)));
+   }
+   static void add(std::vector<program_property>& v, const char* name, int n)
+   {
+      v.push_back(program_property(name, to_string(n), to_string(n)));
+   }
+   void add_optimization(const char* name, bool applied, const char* note)
+   {
+      add(m_optimizations, name, std::string(applied ? "applied" : "not applied") + (*note ? std::string(": ") + note : std::string()));
+   }
+
+   void describe_expression();
+   void describe_states();
+   void describe_alt(program_node& node, const re_alt* alt)const
+   {
+      node.alt = id_of(alt->alt.p);
+      add(node.properties, "can_be_null", static_cast<int>(alt->can_be_null));
+      add(node.properties, "take", program_char_map(alt->_map, mask_take));
+      add(node.properties, "skip", program_char_map(alt->_map, mask_skip));
+   }
+   void print_json(std::ostream& os);
+   void print_dot(std::ostream& os);
+};
+
+template <class charT, class traits>
+void regex_program_printer<charT, traits>::describe_expression()
+{
+   std::string expression;
+   for(std::ptrdiff_t i = 0; i < m_data.m_expression_len; ++i)
+   {
+      unsigned c = program_char_value(m_data.m_expression[i]);
+      if((c >= 0x20) && (c < 0x7f))
+         expression.append(1, static_cast<char>(c));
+      else
+         append_program_char(expression, c);
+   }
+   add(m_properties, "expression", expression);
+   add(m_properties, "flags", static_cast<std::size_t>(m_data.m_flags));
+   add(m_properties, "mark_count", m_data.m_mark_count);
+   add(m_properties, "restart_type", std::string(restart_type_name(m_data.m_restart_type)));
+   add(m_properties, "can_be_null", m_data.m_can_be_null != 0);
+   add(m_properties, "startmap", program_char_map(m_data.m_startmap, mask_any));
+   add(m_properties, "has_backrefs", m_data.m_has_backrefs);
+   add(m_properties, "has_recursions", m_data.m_has_recursions);
+   if(m_data.m_shift_or)
+      add(m_properties, "shift_or_length", m_data.m_shift_or->m_length);
+   //
+   // And then how the matcher will go about searching:
+   //
+   unsigned restart = m_data.m_restart_type;
+   add_optimization("literal_search", (restart == regbase::restart_lit) || (restart == regbase::restart_fixed_lit),
+      (restart == regbase::restart_fixed_lit) ? "the expression is a single literal string"
+      : (restart == regbase::restart_lit) ? "every match starts with a literal string" : "");
+   add_optimization("shift_or_search", static_cast<bool>(m_data.m_shift_or),
+      m_data.m_shift_or ? "each character is examined once"
+      : (restart != regbase::restart_any) ? "a different restart type was chosen"
+      : "the expression is not a short fixed length sequence of single characters");
+   bool anchored = (restart == regbase::restart_line) || (restart == regbase::restart_buf) || (restart == regbase::restart_continue);
+   add_optimization("anchored_search", anchored,
+      (restart == regbase::restart_line) ? "matches are only attempted at the start of a line"
+      : (restart == regbase::restart_buf) ? "a match is only attempted at the start of the text"
+      : (restart == regbase::restart_continue) ? "a match is only attempted where the last one ended" : "");
+   bool all = program_char_map(m_data.m_startmap, mask_any) == "any";
+   add_optimization("startmap", !all && !m_data.m_can_be_null,
+      m_data.m_can_be_null ? "the expression can match the empty string, so every position must be tried"
+      : all ? "any character can start a match, so every position must be tried" : "positions which cannot start a match are skipped");
+   bool leading = false;
+   bool possessive = false;
+   for(const re_syntax_base* state = m_data.m_first_state; state; state = state->next.p)
+   {
+      switch(state->type)
+      {
+      case syntax_element_rep:
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         leading = leading || static_cast<const re_repeat*>(state)->leading;
+         possessive = possessive || static_cast<const re_repeat*>(state)->possessive;
+         break;
+      default:
+         break;
+      }
+   }
+   add_optimization("leading_repeat", leading,
+      leading ? "a failed leading repeat is not retried from positions it has already covered" : "");
+   add_optimization("possessive_repeats", possessive,
+      possessive ? "some repeats are never backtracked into, as what follows them cannot start with a character they match" : "");
+   add_optimization("skip_subexpressions", !m_data.m_has_backrefs && !m_data.m_has_recursions,
+      (m_data.m_has_backrefs || m_data.m_has_recursions) ? "the expression refers to its own sub-expressions" : "regex_search without match_results does not record sub-expressions");
+   add_optimization("memoize", m_data.m_memo_repeats != 0,
+      m_data.m_memo_repeats == 0 ? "there are no unbounded repeats which can be memoized" 
+      : m_data.m_backtracking_hazard ? "failed repeats are recorded with match_memoize, and always for short texts" 
+      : "match_memoize can record failed repeats");
+   add_optimization("remove_inert_groups", (m_data.m_flags & regbase::optimize) != 0,
+      (m_data.m_flags & regbase::optimize) ? "" : "the optimize flag was not set");
+}
+
+template <class charT, class traits>
+void regex_program_printer<charT, traits>::describe_states()
+{
+   int id = 0;
+   for(const re_syntax_base* state = m_data.m_first_state; state; state = state->next.p)
+      m_ids[state] = id++;
+   for(const re_syntax_base* state = m_data.m_first_state; state; state = state->next.p)
+   {
+      program_node node;
+      node.id = id_of(state);
+      node.type = syntax_element_name(state->type);
+      node.next = id_of(state->next.p);
+      node.alt = -1;
+      std::vector<program_property>& p = node.properties;
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+      case syntax_element_backref:
+      case syntax_element_assert_backref:
+         add(p, "index", static_cast<const re_brace*>(state)->index);
+         add(p, "icase", static_cast<const re_brace*>(state)->icase);
+         break;
+      case syntax_element_toggle_case:
+         add(p, "icase", static_cast<const re_case*>(state)->icase);
+         break;
+      case syntax_element_literal:
+         {
+            const re_literal* lit = static_cast<const re_literal*>(state);
+            const charT* pc = reinterpret_cast<const charT*>(lit + 1);
+            std::string s;
+            for(unsigned i = 0; i < lit->length; ++i)
+               append_program_char(s, program_char_value(pc[i]));
+            add(p, "text", s);
+         }
+         break;
+      case syntax_element_wild:
+         add(p, "mask", static_cast<int>(static_cast<const re_dot*>(state)->mask));
+         break;
+      case syntax_element_set:
+         add(p, "set", program_char_map(static_cast<const re_set*>(state)->_map, ~0u));
+         break;
+      case syntax_element_long_set:
+         {
+            typedef typename traits::char_class_type m_type;
+            const re_set_long<m_type>* set = static_cast<const re_set_long<m_type>*>(state);
+            add(p, "singles", static_cast<std::size_t>(set->csingles));
+            add(p, "ranges", static_cast<std::size_t>(set->cranges));
+            add(p, "equivalents", static_cast<std::size_t>(set->cequivalents));
+            add(p, "negated", set->isnot);
+         }
+         break;
+      case syntax_element_jump:
+         node.alt = id_of(static_cast<const re_jump*>(state)->alt.p);
+         break;
+      case syntax_element_recurse:
+         node.alt = id_of(static_cast<const re_jump*>(state)->alt.p);
+         add(p, "state_id", static_cast<const re_recurse*>(state)->state_id);
+         break;
+      case syntax_element_commit:
+         add(p, "action", std::string(static_cast<const re_commit*>(state)->action == commit_prune ? "prune"
+            : static_cast<const re_commit*>(state)->action == commit_skip ? "skip" : "commit"));
+         break;
+      case syntax_element_rep:
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         {
+            const re_repeat* rep = static_cast<const re_repeat*>(state);
+            add(p, "min", rep->min);
+            add(p, "max", rep->max);
+            add(p, "greedy", rep->greedy);
+            add(p, "leading", rep->leading);
+            add(p, "memoize", rep->memoize);
+            add(p, "possessive", rep->possessive);
+            add(p, "state_id", rep->state_id);
+            describe_alt(node, rep);
+         }
+         break;
+      case syntax_element_alt:
+         describe_alt(node, static_cast<const re_alt*>(state));
+         break;
+      default:
+         break;
+      }
+      m_nodes.push_back(node);
+   }
+}
+
+template <class charT, class traits>
+void regex_program_printer<charT, traits>::print_json(std::ostream& os)
+{
+   os << "{\n";
+   for(std::size_t i = 0; i < m_properties.size(); ++i)
+      os << "  \"" << m_properties[i].name << "\": " << m_properties[i].json << ",\n";
+   os << "  \"optimizations\": {";
+   for(std::size_t i = 0; i < m_optimizations.size(); ++i)
+      os << (i ? ",\n" : "\n") << "    \"" << m_optimizations[i].name << "\": " << m_optimizations[i].json;
+   os << "\n  },\n  \"states\": [";
+   for(std::size_t i = 0; i < m_nodes.size(); ++i)
+   {
+      const program_node& n = m_nodes[i];
+      os << (i ? ",\n" : "\n") << "    { \"id\": " << n.id << ", \"type\": \"" << n.type << "\"";
+      if(n.next >= 0)
+         os << ", \"next\": " << n.next;
+      if(n.alt >= 0)
+         os << ", \"alt\": " << n.alt;
+      for(std::size_t j = 0; j < n.properties.size(); ++j)
+         os << ", \"" << n.properties[j].name << "\": " << n.properties[j].json;
+      os << " }";
+   }
+   os << "\n  ]\n}\n";
+}
+
+template <class charT, class traits>
+void regex_program_printer<charT, traits>::print_dot(std::ostream& os)
+{
+   os << "digraph regex {\n  node [shape=box, fontname=\"monospace\"];\n  label=\"";
+   for(std::size_t i = 0; i < m_properties.size(); ++i)
+      os << program_escape(m_properties[i].name + ": " + m_properties[i].dot, regex_program_dot) << "\\l";
+   for(std::size_t i = 0; i < m_optimizations.size(); ++i)
+      os << program_escape(m_optimizations[i].name + ": " + m_optimizations[i].dot, regex_program_dot) << "\\l";
+   os << "\";\n  labeljust=l;\n";
+   for(std::size_t i = 0; i < m_nodes.size(); ++i)
+   {
+      const program_node& n = m_nodes[i];
+      os << "  s" << n.id << " [label=\"" << n.id << ": " << n.type;
+      for(std::size_t j = 0; j < n.properties.size(); ++j)
+         os << "\\n" << program_escape(n.properties[j].name + "=" + n.properties[j].dot, regex_program_dot);
+      os << "\"];\n";
+   }
+   for(std::size_t i = 0; i < m_nodes.size(); ++i)
+   {
+      const program_node& n = m_nodes[i];
+      // a jump never continues to the next state:
+      if(n.type == "jump")
+         os << "  s" << n.id << " -> s" << n.alt << ";\n";
+      else
+      {
+         if(n.next >= 0)
+            os << "  s" << n.id << " -> s" << n.next << ";\n";
+         if(n.alt >= 0)
+            os << "  s" << n.id << " -> s" << n.alt << " [style=dashed, label=\"" << (n.type == "recurse" ? "call" : "alt") << "\"];\n";
+      }
+   }
+   os << "}\n";
+}
+
+template <class charT, class traits>
+void regex_program_printer<charT, traits>::print(std::ostream& os, regex_program_format f)
+{
+   describe_expression();
+   describe_states();
+   if(f == regex_program_dot)
+      print_dot(os);
+   else
+      print_json(os);
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+//
+// print_regex_program:
+// writes a description of the state machine that e was compiled to,
+// and of the optimisations that apply when searching with it:
+//
+template <class charT, class traits>
+void print_regex_program(std::ostream& os, const basic_regex<charT, traits>& e, regex_program_format f = regex_program_json)
+{
+   if(e.empty() || e.status())
+   {
+      if(f == regex_program_dot)
+         os << "digraph regex {\n}\n";
+      else
+         os << "{\n  \"states\": []\n}\n";
+      return;
+   }
+   BOOST_REGEX_DETAIL_NS::regex_program_printer<charT, traits> printer(e);
+   printer.print(os, f);
+}
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // namespace boost
+
+#endif
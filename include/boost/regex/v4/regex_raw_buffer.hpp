@@ -27,6 +27,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <boost/throw_exception.hpp>
 
 namespace boost{
    namespace BOOST_REGEX_DETAIL_NS{
@@ -103,7 +106,9 @@ enum{
 //
 // class raw_storage
 // basically this is a simplified vector<unsigned char>
-// this is used by basic_regex for expression storage
+// this is used by basic_regex for expression storage,
+// the memory comes from std::malloc so that growing
+// a large expression can use std::realloc
 //
 
 class BOOST_REGEX_DECL raw_storage
@@ -120,7 +125,7 @@ public:
 
    ~raw_storage()
    {
-      ::operator delete(start);
+      std::free(start);
    }
 
    void BOOST_REGEX_CALL resize(size_type n);
@@ -181,8 +186,9 @@ inline raw_storage::raw_storage()
 
 inline raw_storage::raw_storage(size_type n)
 {
-   start = end = static_cast<pointer>(::operator new(n));
-   BOOST_REGEX_NOEH_ASSERT(start)
+   start = end = static_cast<pointer>(std::malloc(n));
+   if(start == 0)
+      boost::throw_exception(std::bad_alloc());
    last = start + n;
 }
 
@@ -33,6 +33,21 @@ namespace boost{
 #pragma warning(pop)
 #endif
 
+namespace BOOST_REGEX_DETAIL_NS{
+//
+// When the caller has no interest in the sub-expressions we can tell the
+// matcher not to track them, provided nothing in the expression refers back
+// to a sub-expression's contents while matching:
+//
+template <class charT, class traits>
+inline match_flag_type no_subs_flags(const basic_regex<charT, traits>& e, match_flag_type flags)
+{
+   if(!e.empty() && !e.get_data().m_has_backrefs && !e.get_data().m_has_recursions)
+      flags |= regex_constants::match_nosubs;
+   return flags;
+}
+} // namespace BOOST_REGEX_DETAIL_NS
+
 template <class BidiIterator, class Allocator, class charT, class traits>
 bool regex_search(BidiIterator first, BidiIterator last, 
                   match_results<BidiIterator, Allocator>& m, 
@@ -141,7 +156,7 @@ bool regex_search(BidiIterator first, BidiIterator last,
 
    match_results<BidiIterator> m;
    typedef typename match_results<BidiIterator>::allocator_type match_alloc_type;
-   BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, match_alloc_type, traits> matcher(first, last, m, e, flags | regex_constants::match_any, first);
+   BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, match_alloc_type, traits> matcher(first, last, m, e, BOOST_REGEX_DETAIL_NS::no_subs_flags(e, flags) | regex_constants::match_any, first);
    return matcher.find();
 }
 
@@ -199,6 +214,131 @@ inline bool regex_search(const std::basic_string<wchar_t>& s,
 
 #endif // partial overload
 
+//
+// regex_search with a match_budget:
+// as above, but once the budget is exhausted gives up and returns false,
+// rather than throwing, budget.status() then records why:
+//
+template <class BidiIterator, class Allocator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last, 
+                  match_results<BidiIterator, Allocator>& m, 
+                  const basic_regex<charT, traits>& e, 
+                  match_budget& budget,
+                  match_flag_type flags = match_default)
+{
+   if(e.flags() & regex_constants::failbit)
+   {
+      budget.begin();
+      return false;
+   }
+
+   typedef BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, Allocator, traits> matcher_type;
+   matcher_type matcher(first, last, m, e, flags, first);
+   return BOOST_REGEX_DETAIL_NS::call_within_budget(matcher, &matcher_type::find, budget);
+}
+
+template <class BidiIterator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last, 
+                  const basic_regex<charT, traits>& e, 
+                  match_budget& budget,
+                  match_flag_type flags = match_default)
+{
+   if(e.flags() & regex_constants::failbit)
+   {
+      budget.begin();
+      return false;
+   }
+
+   match_results<BidiIterator> m;
+   typedef typename match_results<BidiIterator>::allocator_type match_alloc_type;
+   typedef BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, match_alloc_type, traits> matcher_type;
+   matcher_type matcher(first, last, m, e, BOOST_REGEX_DETAIL_NS::no_subs_flags(e, flags) | regex_constants::match_any, first);
+   return BOOST_REGEX_DETAIL_NS::call_within_budget(matcher, &matcher_type::find, budget);
+}
+
+#ifndef BOOST_NO_FUNCTION_TEMPLATE_ORDERING
+template <class ST, class SA, class Allocator, class charT, class traits>
+inline bool regex_search(const std::basic_string<charT, ST, SA>& s, 
+                 match_results<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& m, 
+                 const basic_regex<charT, traits>& e, 
+                 match_budget& budget,
+                 match_flag_type flags = match_default)
+{
+   return regex_search(s.begin(), s.end(), m, e, budget, flags);
+}
+
+template <class ST, class SA, class charT, class traits>
+inline bool regex_search(const std::basic_string<charT, ST, SA>& s, 
+                 const basic_regex<charT, traits>& e, 
+                 match_budget& budget,
+                 match_flag_type flags = match_default)
+{
+   return regex_search(s.begin(), s.end(), e, budget, flags);
+}
+#endif
+
+//
+// regex_contains:
+// true if there is a match anywhere within [first, last), no sub-expression
+// information is recorded while looking for it:
+//
+template <class BidiIterator, class charT, class traits>
+bool regex_contains(BidiIterator first, BidiIterator last, 
+                    const basic_regex<charT, traits>& e, 
+                    match_flag_type flags = match_default)
+{
+   return regex_search(first, last, e, flags);
+}
+
+#ifndef BOOST_NO_FUNCTION_TEMPLATE_ORDERING
+
+template <class charT, class traits>
+inline bool regex_contains(const charT* str, 
+                           const basic_regex<charT, traits>& e, 
+                           match_flag_type flags = match_default)
+{
+   return regex_contains(str, str + traits::length(str), e, flags);
+}
+
+template <class ST, class SA, class charT, class traits>
+inline bool regex_contains(const std::basic_string<charT, ST, SA>& s, 
+                           const basic_regex<charT, traits>& e, 
+                           match_flag_type flags = match_default)
+{
+   return regex_contains(s.begin(), s.end(), e, flags);
+}
+#else  // non-template function overloads
+inline bool regex_contains(const char* str, 
+                           const regex& e, 
+                           match_flag_type flags = match_default)
+{
+   return regex_contains(str, str + regex::traits_type::length(str), e, flags);
+}
+#ifndef BOOST_NO_WREGEX
+inline bool regex_contains(const wchar_t* str, 
+                           const wregex& e, 
+                           match_flag_type flags = match_default)
+{
+   return regex_contains(str, str + wregex::traits_type::length(str), e, flags);
+}
+#endif
+inline bool regex_contains(const std::string& s, 
+                           const regex& e, 
+                           match_flag_type flags = match_default)
+{
+   return regex_contains(s.begin(), s.end(), e, flags);
+}
+#if !defined(BOOST_NO_WREGEX)
+inline bool regex_contains(const std::basic_string<wchar_t>& s, 
+                           const wregex& e, 
+                           match_flag_type flags = match_default)
+{
+   return regex_contains(s.begin(), s.end(), e, flags);
+}
+#endif // BOOST_NO_WREGEX
+
+#endif // partial overload
+
 #ifdef BOOST_MSVC
 #pragma warning(push)
 #pragma warning(disable: 4103)
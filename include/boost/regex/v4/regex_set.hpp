@@ -0,0 +1,391 @@
+/*
+ *
+ * Copyright (c) 2016
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_set.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares basic_regex_set, an immutable alternation of
+  *                many expressions, and basic_regex_set_builder which
+  *                maintains one, recompiling only what has changed.
+  */
+
+#ifndef BOOST_REGEX_V4_REGEX_SET_HPP
+#define BOOST_REGEX_V4_REGEX_SET_HPP
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+namespace boost{
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+template <class charT, class traits>
+class basic_regex_set_builder;
+
+//
+// basic_regex_set:
+// behaves as the expression (a|b|c...) compiled with nosubs, but is held as
+// several smaller expressions, each an alternation of consecutive members, so
+// that changing one member requires only its own part to be recompiled.
+// Copies share the compiled expressions, and are safe to use from several
+// threads at once just as basic_regex is.
+//
+template <class charT, class traits = regex_traits<charT> >
+class basic_regex_set
+{
+public:
+   typedef basic_regex<charT, traits>                 regex_type;
+   typedef typename regex_type::flag_type             flag_type;
+   typedef std::size_t                                size_type;
+
+   basic_regex_set() : m_flags(regex_constants::normal), m_size(0) {}
+
+   // the number of expressions in the set:
+   size_type size()const
+   { return m_size; }
+   bool empty()const
+   { return m_size == 0; }
+   flag_type flags()const
+   { return m_flags; }
+   // the number of separately compiled parts:
+   size_type parts()const
+   { return m_parts.get() ? m_parts->size() : 0; }
+
+   //
+   // search: finds the same match as regex_search would with the whole
+   // alternation, only $0 is set in m:
+   //
+   template <class BidiIterator, class Allocator>
+   bool search(BidiIterator first, BidiIterator last, match_results<BidiIterator, Allocator>& m, match_flag_type flags = match_default)const
+   {
+      if(!m_parts.get())
+         return false;
+      bool longest = is_leftmost_longest(flags);
+      match_results<BidiIterator, Allocator> what(m.get_allocator());
+      bool found = false;
+      for(typename std::vector<regex_type>::const_iterator i = m_parts->begin(); i != m_parts->end(); ++i)
+      {
+         if(!regex_search(first, last, found ? what : m, *i, flags, first))
+            continue;
+         if(found)
+         {
+            // an earlier part wins a tie, just as an earlier alternative would:
+            if((what.position() < m.position()) || (longest && (what.position() == m.position()) && (what.length() > m.length())))
+               m.swap(what);
+         }
+         found = true;
+         if(!longest && (m.position() == 0))
+            break;
+      }
+      return found;
+   }
+   template <class BidiIterator>
+   bool search(BidiIterator first, BidiIterator last, match_flag_type flags = match_default)const
+   {
+      if(!m_parts.get())
+         return false;
+      for(typename std::vector<regex_type>::const_iterator i = m_parts->begin(); i != m_parts->end(); ++i)
+      {
+         if(regex_search(first, last, *i, flags))
+            return true;
+      }
+      return false;
+   }
+   //
+   // match: true if any member matches all of [first, last):
+   //
+   template <class BidiIterator, class Allocator>
+   bool match(BidiIterator first, BidiIterator last, match_results<BidiIterator, Allocator>& m, match_flag_type flags = match_default)const
+   {
+      if(!m_parts.get())
+         return false;
+      for(typename std::vector<regex_type>::const_iterator i = m_parts->begin(); i != m_parts->end(); ++i)
+      {
+         if(regex_match(first, last, m, *i, flags))
+            return true;
+      }
+      return false;
+   }
+   template <class BidiIterator>
+   bool match(BidiIterator first, BidiIterator last, match_flag_type flags = match_default)const
+   {
+      if(!m_parts.get())
+         return false;
+      for(typename std::vector<regex_type>::const_iterator i = m_parts->begin(); i != m_parts->end(); ++i)
+      {
+         if(regex_match(first, last, *i, flags))
+            return true;
+      }
+      return false;
+   }
+   //
+   // and the same for strings:
+   //
+   template <class ST, class SA, class Allocator>
+   bool search(const std::basic_string<charT, ST, SA>& s, match_results<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& m, match_flag_type flags = match_default)const
+   { return search(s.begin(), s.end(), m, flags); }
+   template <class ST, class SA>
+   bool search(const std::basic_string<charT, ST, SA>& s, match_flag_type flags = match_default)const
+   { return search(s.begin(), s.end(), flags); }
+   template <class ST, class SA, class Allocator>
+   bool match(const std::basic_string<charT, ST, SA>& s, match_results<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& m, match_flag_type flags = match_default)const
+   { return match(s.begin(), s.end(), m, flags); }
+   template <class ST, class SA>
+   bool match(const std::basic_string<charT, ST, SA>& s, match_flag_type flags = match_default)const
+   { return match(s.begin(), s.end(), flags); }
+
+private:
+   friend class basic_regex_set_builder<charT, traits>;
+
+   basic_regex_set(const shared_ptr<const std::vector<regex_type> >& parts, flag_type f, size_type n)
+      : m_parts(parts), m_flags(f), m_size(n) {}
+
+   bool is_leftmost_longest(match_flag_type flags)const
+   {
+      // as perl_matcher decides, but only perl and POSIX extended syntax are used here:
+      if(flags & (match_perl|match_posix))
+         return (flags & match_posix) != 0;
+      return (m_flags & regbase::no_perl_ex) != 0;
+   }
+
+   shared_ptr<const std::vector<regex_type> > m_parts;
+   flag_type m_flags;
+   size_type m_size;
+};
+
+//
+// basic_regex_set_builder:
+// holds the members of a basic_regex_set, in the order in which they were
+// inserted, divided into parts of at most part_size members; build() only
+// recompiles the parts which have changed since the last call.
+//
+template <class charT, class traits = regex_traits<charT> >
+class basic_regex_set_builder
+{
+public:
+   typedef basic_regex_set<charT, traits>             set_type;
+   typedef basic_regex<charT, traits>                 regex_type;
+   typedef typename regex_type::flag_type             flag_type;
+   typedef std::basic_string<charT>                   string_type;
+   typedef std::size_t                                size_type;
+
+   explicit basic_regex_set_builder(flag_type f = regex_constants::normal, size_type part_size = 1024)
+      : m_flags(f), m_part_size(part_size ? part_size : 1), m_erased_parts(false)
+   {
+      if(f & (regbase::literal | regbase::basic_syntax_group))
+      {
+         std::invalid_argument e("A regex set requires perl or POSIX extended syntax.");
+         boost::throw_exception(e);
+      }
+   }
+
+   //
+   // insert: adds s to the end of the set, returns false if it's already
+   // present, and throws regex_error if it is not a valid expression, or
+   // contains back-references or recursions (which would refer to the wrong
+   // sub-expression once combined with the other members):
+   //
+   bool insert(const string_type& s)
+   {
+      if(m_index.find(s) != m_index.end())
+         return false;
+      check(s);
+      if(m_parts.empty() || (m_parts.back().members.size() >= m_part_size))
+         m_parts.push_back(part());
+      m_parts.back().members.push_back(s);
+      m_parts.back().changed = true;
+      try{
+         m_index.insert(std::make_pair(s, m_parts.size() - 1));
+      }
+      catch(...)
+      {
+         m_parts.back().members.pop_back();
+         m_erased_parts = m_parts.back().members.empty();
+         throw;
+      }
+      return true;
+   }
+   template <class ForwardIterator>
+   void insert(ForwardIterator first, ForwardIterator last)
+   {
+      for(; first != last; ++first)
+         insert(string_type(*first));
+   }
+   //
+   // erase: removes s, returns false if it was not present:
+   //
+   bool erase(const string_type& s)
+   {
+      typename std::map<string_type, size_type>::iterator pos = m_index.find(s);
+      if(pos == m_index.end())
+         return false;
+      part& p = m_parts[pos->second];
+      p.members.erase(std::find(p.members.begin(), p.members.end(), s));
+      p.changed = true;
+      if(p.members.empty())
+         m_erased_parts = true;
+      m_index.erase(pos);
+      return true;
+   }
+   bool contains(const string_type& s)const
+   { return m_index.find(s) != m_index.end(); }
+   void clear()
+   {
+      m_parts.clear();
+      m_index.clear();
+      m_erased_parts = false;
+   }
+   size_type size()const
+   { return m_index.size(); }
+   bool empty()const
+   { return m_index.empty(); }
+   flag_type flags()const
+   { return m_flags; }
+
+   //
+   // build: returns a set containing the current members, sets obtained
+   // from earlier calls are unchanged and share the parts that are:
+   //
+   set_type build()
+   {
+      if(m_erased_parts)
+         remove_empty_parts();
+      shared_ptr<std::vector<regex_type> > result(new std::vector<regex_type>());
+      result->reserve(m_parts.size());
+      for(typename std::vector<part>::iterator i = m_parts.begin(); i != m_parts.end(); ++i)
+      {
+         if(i->members.empty())
+            continue;
+         if(i->changed)
+         {
+            i->expression = compile(i->members);
+            i->changed = false;
+         }
+         result->push_back(i->expression);
+      }
+      return set_type(result, m_flags, size());
+   }
+
+private:
+   struct part
+   {
+      part() : changed(false) {}
+      std::vector<string_type> members;
+      regex_type expression;
+      bool changed;
+   };
+
+   void check(const string_type& s)const
+   {
+      //
+      // Compile s as it will appear in its part, but with sub-expressions
+      // marked, the first must then span the whole of s, otherwise s has
+      // closed the group early (as in "a)|(b") or commented out its end:
+      //
+      string_type t;
+      t.reserve(s.size() + 2);
+      t.append(1, charT('('));
+      t.append(s);
+      t.append(1, charT(')'));
+      regex_type e(t, (m_flags & ~regbase::nosubs) | regbase::save_subexpression_location);
+      std::pair<typename regex_type::const_iterator, typename regex_type::const_iterator> whole = e.subexpression(0);
+      if((whole.first != e.begin()) || (whole.second + 1 != e.end()))
+      {
+         regex_error err("Each member of a regex set must be a complete expression.", regex_constants::error_paren, 0);
+         boost::throw_exception(err);
+      }
+      if(e.get_data().m_has_backrefs || e.get_data().m_has_recursions)
+      {
+         regex_error err("Back-references and recursions are not supported in a regex set.", regex_constants::error_backref, 0);
+         boost::throw_exception(err);
+      }
+   }
+
+   regex_type compile(const std::vector<string_type>& members)const
+   {
+      string_type t;
+      size_type len = 0;
+      for(typename std::vector<string_type>::const_iterator i = members.begin(); i != members.end(); ++i)
+         len += i->size() + 3;
+      t.reserve(len);
+      for(typename std::vector<string_type>::const_iterator i = members.begin(); i != members.end(); ++i)
+      {
+         // each member is grouped so that any (?imsx) within it ends with it:
+         if(i != members.begin())
+            t.append(1, charT('|'));
+         t.append(1, charT('('));
+         t.append(*i);
+         t.append(1, charT(')'));
+      }
+      return regex_type(t, m_flags | regbase::nosubs);
+   }
+
+   void remove_empty_parts()
+   {
+      std::vector<part> parts;
+      parts.reserve(m_parts.size());
+      for(typename std::vector<part>::const_iterator i = m_parts.begin(); i != m_parts.end(); ++i)
+      {
+         if(!i->members.empty())
+            parts.push_back(*i);
+      }
+      std::map<string_type, size_type> index;
+      for(size_type i = 0; i < parts.size(); ++i)
+      {
+         for(typename std::vector<string_type>::const_iterator j = parts[i].members.begin(); j != parts[i].members.end(); ++j)
+            index.insert(std::make_pair(*j, i));
+      }
+      m_parts.swap(parts);
+      m_index.swap(index);
+      m_erased_parts = false;
+   }
+
+   std::vector<part> m_parts;
+   std::map<string_type, size_type> m_index;
+   flag_type m_flags;
+   size_type m_part_size;
+   bool m_erased_parts;
+};
+
+typedef basic_regex_set<char> regex_set;
+typedef basic_regex_set_builder<char> regex_set_builder;
+#ifndef BOOST_NO_WREGEX
+typedef basic_regex_set<wchar_t> wregex_set;
+typedef basic_regex_set_builder<wchar_t> wregex_set_builder;
+#endif
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // namespace boost
+
+#endif  // BOOST_REGEX_V4_REGEX_SET_HPP
@@ -97,6 +97,56 @@ bool split_pred<OutputIterator, charT, Traits1, Alloc1>::operator()
    return true;
 }
 
+//
+// as split_pred, but outputs the sub_match's themselves, rather
+// than copies of the text they refer to:
+//
+template <class OutputIterator, class BidiIterator>
+class split_range_pred
+{
+   BidiIterator* p_last;
+   OutputIterator* p_out;
+   std::size_t* p_max;
+   std::size_t initial_max;
+public:
+   split_range_pred(BidiIterator* a, OutputIterator* b, std::size_t* c)
+      : p_last(a), p_out(b), p_max(c), initial_max(*c) {}
+
+   bool operator()(const match_results<BidiIterator>& what);
+};
+
+template <class OutputIterator, class BidiIterator>
+bool split_range_pred<OutputIterator, BidiIterator>::operator()
+   (const match_results<BidiIterator>& what)
+{
+   *p_last = what[0].second;
+   if(what.size() > 1)
+   {
+      // output sub-expressions only:
+      for(unsigned i = 1; i < what.size(); ++i)
+      {
+         *(*p_out) = what[i];
+         ++(*p_out);
+         if(0 == --*p_max) return false;
+      }
+      return *p_max != 0;
+   }
+   else
+   {
+      // output $` only if it's not-null or not at the start of the input:
+      const sub_match<BidiIterator>& sub = what[-1];
+      if((sub.first != sub.second) || (*p_max != initial_max))
+      {
+         *(*p_out) = sub;
+         ++(*p_out);
+         return --*p_max;
+      }
+   }
+   //
+   // initial null, do nothing:
+   return true;
+}
+
 } // namespace BOOST_REGEX_DETAIL_NS
 
 template <class OutputIterator, class charT, class Traits1, class Alloc1, class Traits2>
@@ -150,6 +200,65 @@ inline std::size_t regex_split(OutputIterator out,
    return regex_split(out, s, BOOST_REGEX_DETAIL_NS::get_default_expression(charT(0)), match_default, UINT_MAX);
 }
 
+//
+// Non-destructive forms: these output sub_match<BidiIterator> objects referring 
+// into the input sequence rather than copies of the text, and instead of erasing 
+// the processed input they advance first past it:
+//
+template <class OutputIterator, class BidiIterator, class charT, class traits>
+std::size_t regex_split(OutputIterator out,
+                   BidiIterator& first, BidiIterator last,
+                   const basic_regex<charT, traits>& e,
+                   match_flag_type flags,
+                   std::size_t max_split)
+{
+   BidiIterator processed = first;
+   std::size_t init_size = max_split;
+   BOOST_REGEX_DETAIL_NS::split_range_pred<OutputIterator, BidiIterator> pred(&processed, &out, &max_split);
+   regex_grep(pred, first, last, e, flags);
+   //
+   // if there is still input left, do a final push as long as max_split
+   // is not exhausted, and we're not splitting sub-expressions rather 
+   // than whitespace:
+   if(max_split && (processed != last) && (e.mark_count() == 0))
+   {
+      sub_match<BidiIterator> rest;
+      rest.first = processed;
+      rest.second = last;
+      rest.matched = true;
+      *out = rest;
+      ++out;
+      processed = last;
+      --max_split;
+   }
+   first = processed;
+   //
+   // return the number of new records pushed:
+   return init_size - max_split;
+}
+
+template <class OutputIterator, class BidiIterator, class charT, class traits>
+inline std::size_t regex_split(OutputIterator out,
+                   BidiIterator& first, BidiIterator last,
+                   const basic_regex<charT, traits>& e,
+                   match_flag_type flags = match_default)
+{
+   return regex_split(out, first, last, e, flags, UINT_MAX);
+}
+
+//
+// Splits into a fixed size array: no more than N fields are written, and no
+// memory is allocated for them:
+//
+template <class BidiIterator, std::size_t N, class charT, class traits>
+inline std::size_t regex_split(sub_match<BidiIterator> (&fields)[N],
+                   BidiIterator& first, BidiIterator last,
+                   const basic_regex<charT, traits>& e,
+                   match_flag_type flags = match_default)
+{
+   return regex_split(static_cast<sub_match<BidiIterator>*>(fields), first, last, e, flags, N);
+}
+
 #ifdef BOOST_MSVC
 #  pragma warning(pop)
 #endif
@@ -20,6 +20,8 @@
 #define BOOST_REGEX_V4_REGEX_TOKEN_ITERATOR_HPP
 
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/detail/workaround.hpp>
 #if (BOOST_WORKAROUND(__BORLANDC__, >= 0x560) && BOOST_WORKAROUND(__BORLANDC__, BOOST_TESTED_AT(0x570)))\
       || BOOST_WORKAROUND(__MWERKS__, BOOST_TESTED_AT(0x3003))
@@ -55,21 +57,28 @@ class regex_token_iterator_implementation
 {
    typedef basic_regex<charT, traits> regex_type;
    typedef sub_match<BidirectionalIterator>      value_type;
+   typedef BOOST_REGEX_DETAIL_NS::perl_matcher<BidirectionalIterator, typename match_results<BidirectionalIterator>::allocator_type, traits> matcher_type;
 
    match_results<BidirectionalIterator> what;   // current match
    BidirectionalIterator                base;    // start of search area
    BidirectionalIterator                end;    // end of search area
    const regex_type                     re;    // the expression
    match_flag_type                      flags;  // match flags
-   value_type                           result; // the current string result
-   int                                  N;      // the current sub-expression being enumerated
    std::vector<int>                     subs;   // the sub-expressions to enumerate
+   scoped_ptr<matcher_type>             matcher; // reused for each search, created on demand
+
+   // the current string result and the index of the sub-expression being
+   // enumerated are kept by each iterator, so that iterators which share
+   // this object can step through the sub-expressions of the current match
+   // without having to copy it:
 
 public:
    regex_token_iterator_implementation(const regex_type* p, BidirectionalIterator last, int sub, match_flag_type f)
       : end(last), re(*p), flags(f){ subs.push_back(sub); }
    regex_token_iterator_implementation(const regex_type* p, BidirectionalIterator last, const std::vector<int>& v, match_flag_type f)
       : end(last), re(*p), flags(f), subs(v){}
+   regex_token_iterator_implementation(const regex_token_iterator_implementation& that)
+      : what(that.what), base(that.base), end(that.end), re(that.re), flags(that.flags), subs(that.subs){}
 #if !BOOST_WORKAROUND(__HP_aCC, < 60700)
 #if (BOOST_WORKAROUND(__BORLANDC__, >= 0x560) && BOOST_WORKAROUND(__BORLANDC__, BOOST_TESTED_AT(0x570)))\
       || BOOST_WORKAROUND(__MWERKS__, BOOST_TESTED_AT(0x3003)) \
@@ -98,11 +107,11 @@ public:
    }
 #endif
 #endif
-   bool init(BidirectionalIterator first)
+   bool init(BidirectionalIterator first, int& N, value_type& result)
    {
       N = 0;
       base = first;
-      if(regex_search(first, end, what, re, flags, base) == true)
+      if(search(first, flags) == true)
       {
          N = 0;
          result = ((subs[N] == -1) ? what.prefix() : what[(int)subs[N]]);
@@ -124,13 +133,13 @@ public:
       return (&re.get_data() == &that.re.get_data()) 
          && (end == that.end) 
          && (flags == that.flags) 
-         && (N == that.N) 
          && (what[0].first == that.what[0].first) 
          && (what[0].second == that.what[0].second);
    }
-   const value_type& get()
-   { return result; }
-   bool next()
+   // true if moving on from sub-expression N requires a new match:
+   bool needs_new_match(int N)const
+   { return (N != -1) && (N+1 >= (int)subs.size()); }
+   bool next(int& N, value_type& result)
    {
       if(N == -1)
          return false;
@@ -143,7 +152,7 @@ public:
       //if(what.prefix().first != what[0].second)
       //   flags |= /*match_prev_avail |*/ regex_constants::match_not_bob;
       BidirectionalIterator last_end(what[0].second);
-      if(regex_search(last_end, end, what, re, ((what[0].first == what[0].second) ? flags | regex_constants::match_not_initial_null : flags), base))
+      if(search(last_end, ((what[0].first == what[0].second) ? flags | regex_constants::match_not_initial_null : flags)))
       {
          N =0;
          result =((subs[N] == -1) ? what.prefix() : what[subs[N]]);
@@ -160,6 +169,16 @@ public:
       return false;
    }
 private:
+   bool search(BidirectionalIterator first, match_flag_type f)
+   {
+      if(re.flags() & regex_constants::failbit)
+         return false;
+      if(matcher.get())
+         matcher->reset(first, f);
+      else
+         matcher.reset(new matcher_type(first, end, what, re, f, base));
+      return matcher->find();
+   }
    regex_token_iterator_implementation& operator=(const regex_token_iterator_implementation&);
 };
 
@@ -188,19 +207,19 @@ public:
    typedef          const value_type&                                       reference; 
    typedef          std::forward_iterator_tag                               iterator_category;
    
-   regex_token_iterator(){}
+   regex_token_iterator() : index(0) {}
    regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b, const regex_type& re, 
                         int submatch = 0, match_flag_type m = match_default)
-                        : pdata(new impl(&re, b, submatch, m))
+                        : pdata(boost::make_shared<impl>(&re, b, submatch, m))
    {
-      if(!pdata->init(a))
+      if(!pdata->init(a, index, result))
          pdata.reset();
    }
    regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b, const regex_type& re, 
                         const std::vector<int>& submatches, match_flag_type m = match_default)
-                        : pdata(new impl(&re, b, submatches, m))
+                        : pdata(boost::make_shared<impl>(&re, b, submatches, m))
    {
-      if(!pdata->init(a))
+      if(!pdata->init(a, index, result))
          pdata.reset();
    }
 #if !BOOST_WORKAROUND(__HP_aCC, < 60700)
@@ -210,45 +229,60 @@ public:
    template <class T>
    regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b, const regex_type& re,
                         const T& submatches, match_flag_type m = match_default)
-                        : pdata(new impl(&re, b, submatches, m))
+                        : pdata(boost::make_shared<impl>(&re, b, submatches, m))
    {
-      if(!pdata->init(a))
+      if(!pdata->init(a, index, result))
          pdata.reset();
    }
 #else
    template <std::size_t N>
    regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b, const regex_type& re,
                         const int (&submatches)[N], match_flag_type m = match_default)
-                        : pdata(new impl(&re, b, submatches, m))
+                        : pdata(boost::make_shared<impl>(&re, b, submatches, m))
    {
-      if(!pdata->init(a))
+      if(!pdata->init(a, index, result))
          pdata.reset();
    }
 #endif
 #endif
    regex_token_iterator(const regex_token_iterator& that)
-      : pdata(that.pdata) {}
+      : pdata(that.pdata), index(that.index), result(that.result) {}
    regex_token_iterator& operator=(const regex_token_iterator& that)
    {
       pdata = that.pdata;
+      index = that.index;
+      result = that.result;
       return *this;
    }
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+   regex_token_iterator(regex_token_iterator&& that)
+      : pdata(static_cast<pimpl&&>(that.pdata)), index(that.index), result(that.result) {}
+   regex_token_iterator& operator=(regex_token_iterator&& that)
+   {
+      pdata = static_cast<pimpl&&>(that.pdata);
+      index = that.index;
+      result = that.result;
+      return *this;
+   }
+#endif
    bool operator==(const regex_token_iterator& that)const
    { 
       if((pdata.get() == 0) || (that.pdata.get() == 0))
          return pdata.get() == that.pdata.get();
-      return pdata->compare(*(that.pdata.get())); 
+      return (index == that.index) && pdata->compare(*(that.pdata.get())); 
    }
    bool operator!=(const regex_token_iterator& that)const
    { return !(*this == that); }
    const value_type& operator*()const
-   { return pdata->get(); }
+   { return result; }
    const value_type* operator->()const
-   { return &(pdata->get()); }
+   { return &result; }
    regex_token_iterator& operator++()
    {
-      cow();
-      if(0 == pdata->next())
+      // only moving on to a new match changes the shared state:
+      if(pdata->needs_new_match(index))
+         cow();
+      if(0 == pdata->next(index, result))
       {
          pdata.reset();
       }
@@ -262,14 +296,16 @@ public:
    }
 private:
 
-   pimpl pdata;
+   pimpl      pdata;
+   int        index;   // the current sub-expression being enumerated
+   value_type result;  // the current string result
 
    void cow()
    {
       // copy-on-write
       if(pdata.get() && !pdata.unique())
       {
-         pdata.reset(new impl(*(pdata.get())));
+         pdata = boost::make_shared<impl>(*(pdata.get()));
       }
    }
 };
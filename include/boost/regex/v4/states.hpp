@@ -251,6 +251,8 @@ struct re_repeat : public re_alt
    int           state_id;        // Unique identifier for this repeat
    bool          leading;   // True if this repeat is at the start of the machine (lets us optimize some searches)
    bool          greedy;    // True if this is a greedy repeat
+   bool          memoize;   // True if failures of this repeat can be recorded by position (see match_memoize)
+   bool          possessive; // True if backtracking into this repeat can never lead to a match
 };
 
 /*** struct re_recurse ************************************************
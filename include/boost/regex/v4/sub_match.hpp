@@ -19,6 +19,15 @@
 #ifndef BOOST_REGEX_V4_SUB_MATCH_HPP
 #define BOOST_REGEX_V4_SUB_MATCH_HPP
 
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/mpl/bool.hpp>
+#ifndef BOOST_NO_CXX11_HDR_FUNCTIONAL
+#include <functional>
+#endif
+
 #ifdef BOOST_MSVC
 #pragma warning(push)
 #pragma warning(disable: 4103)
@@ -32,6 +41,83 @@
 
 namespace boost{
 
+namespace BOOST_REGEX_DETAIL_NS{
+
+//
+// True for iterators known to refer to characters stored contiguously:
+//
+template <class I>
+struct is_string_iterator
+{
+   BOOST_STATIC_CONSTANT(bool, value = (::boost::is_same<I, std::string::const_iterator>::value || ::boost::is_same<I, std::string::iterator>::value));
+};
+#ifndef BOOST_NO_STD_WSTRING
+template <class I>
+struct is_wstring_iterator
+{
+   BOOST_STATIC_CONSTANT(bool, value = (::boost::is_same<I, std::wstring::const_iterator>::value || ::boost::is_same<I, std::wstring::iterator>::value));
+};
+#else
+template <class I>
+struct is_wstring_iterator
+{
+   BOOST_STATIC_CONSTANT(bool, value = false);
+};
+#endif
+template <class I>
+struct is_contiguous_iterator
+{
+   BOOST_STATIC_CONSTANT(bool, value = (::boost::is_pointer<I>::value || is_string_iterator<I>::value || is_wstring_iterator<I>::value));
+};
+
+//
+// Compares [f1, l1) with [f2, l2) in the same way as std::basic_string<charT, traits>::compare,
+// but without copying either sequence:
+//
+template <class traits, class I1, class I2>
+int compare_sequences(I1 f1, I1 l1, I2 f2, I2 l2, const mpl::false_&)
+{
+   while((f1 != l1) && (f2 != l2))
+   {
+      if(traits::lt(*f1, *f2))
+         return -1;
+      if(traits::lt(*f2, *f1))
+         return 1;
+      ++f1;
+      ++f2;
+   }
+   return (f1 != l1) ? 1 : (f2 != l2) ? -1 : 0;
+}
+template <class traits, class I1, class I2>
+int compare_sequences(I1 f1, I1 l1, I2 f2, I2 l2, const mpl::true_&)
+{
+   std::size_t n1 = static_cast<std::size_t>(l1 - f1);
+   std::size_t n2 = static_cast<std::size_t>(l2 - f2);
+   int result = (n1 && n2) ? traits::compare(&*f1, &*f2, (std::min)(n1, n2)) : 0;
+   if(result == 0)
+      result = (n1 < n2) ? -1 : (n1 > n2) ? 1 : 0;
+   return result;
+}
+template <class traits, class I1, class I2>
+inline int compare_sequences(I1 f1, I1 l1, I2 f2, I2 l2)
+{
+   typedef mpl::bool_<is_contiguous_iterator<I1>::value && is_contiguous_iterator<I2>::value> tag_type;
+   return compare_sequences<traits>(f1, l1, f2, l2, tag_type());
+}
+//
+// Compares a sub-expression with the characters [p, p+len), an unmatched
+// sub-expression is treated as an empty string:
+//
+template <class traits, class BidiIterator>
+inline int compare_sub_match(BidiIterator first, BidiIterator last, bool matched, const typename traits::char_type* p, std::size_t len)
+{
+   if(!matched)
+      return len ? -1 : 0;
+   return compare_sequences<traits>(first, last, p, p + len);
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
 template <class BidiIterator>
 struct sub_match : public std::pair<BidiIterator, BidiIterator>
 {
@@ -84,19 +170,35 @@ struct sub_match : public std::pair<BidiIterator, BidiIterator>
       }
       return result;
    }
+   //
+   // The comparisons work directly on the matched characters, no strings are created:
+   //
    int compare(const sub_match& s)const
    {
       if(matched != s.matched)
          return static_cast<int>(matched) - static_cast<int>(s.matched);
-      return str().compare(s.str());
+      if(!matched)
+         return 0;
+      return BOOST_REGEX_DETAIL_NS::compare_sequences<std::char_traits<value_type> >(this->first, this->second, s.first, s.second);
    }
    int compare(const std::basic_string<value_type>& s)const
    {
-      return str().compare(s);
+      return BOOST_REGEX_DETAIL_NS::compare_sub_match<std::char_traits<value_type> >(this->first, this->second, matched, s.data(), s.size());
    }
    int compare(const value_type* p)const
    {
-      return str().compare(p);
+      return BOOST_REGEX_DETAIL_NS::compare_sub_match<std::char_traits<value_type> >(this->first, this->second, matched, p, std::char_traits<value_type>::length(p));
+   }
+   //
+   // The matched characters without copying them, for iterators into contiguous storage
+   // (pointers, and std::basic_string iterators) only:
+   //
+   basic_string_ref<value_type> view()const
+   {
+      BOOST_STATIC_ASSERT(BOOST_REGEX_DETAIL_NS::is_contiguous_iterator<BidiIterator>::value);
+      if(!matched || (this->first == this->second))
+         return basic_string_ref<value_type>();
+      return basic_string_ref<value_type>(&*this->first, static_cast<std::size_t>(this->second - this->first));
    }
 
    bool operator==(const sub_match& that)const
@@ -193,157 +295,167 @@ typedef sub_match<const wchar_t*> wcsub_match;
 typedef sub_match<std::wstring::const_iterator> wssub_match;
 #endif
 
+namespace BOOST_REGEX_DETAIL_NS{
+
+template <class BidiIterator>
+inline int compare_to_char(const sub_match<BidiIterator>& m, typename sub_match<BidiIterator>::value_type const& c)
+{
+   return compare_sub_match<std::char_traits<typename sub_match<BidiIterator>::value_type> >(m.first, m.second, m.matched, &c, 1);
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
 // comparison to std::basic_string<> part 1:
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator == (const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return s.compare(m.str()) == 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) == 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator != (const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return s.compare(m.str()) != 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) != 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator < (const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s,
                  const sub_match<RandomAccessIterator>& m)
-{ return s.compare(m.str()) < 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) > 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator <= (const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return s.compare(m.str()) <= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) >= 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator >= (const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return s.compare(m.str()) >= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) <= 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator > (const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s,
                  const sub_match<RandomAccessIterator>& m)
-{ return s.compare(m.str()) > 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) < 0; }
 // comparison to std::basic_string<> part 2:
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator == (const sub_match<RandomAccessIterator>& m,
                   const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s)
-{ return m.str().compare(s) == 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) == 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator != (const sub_match<RandomAccessIterator>& m,
                   const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s)
-{ return m.str().compare(s) != 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) != 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator < (const sub_match<RandomAccessIterator>& m,
                   const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s)
-{ return m.str().compare(s) < 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) < 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator > (const sub_match<RandomAccessIterator>& m,
                   const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s)
-{ return m.str().compare(s) > 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) > 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator <= (const sub_match<RandomAccessIterator>& m,
                   const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s)
-{ return m.str().compare(s) <= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) <= 0; }
 template <class RandomAccessIterator, class traits, class Allocator>
 inline bool operator >= (const sub_match<RandomAccessIterator>& m,
                   const std::basic_string<typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type, traits, Allocator>& s)
-{ return m.str().compare(s) >= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_sub_match<traits>(m.first, m.second, m.matched, s.data(), s.size()) >= 0; }
 // comparison to const charT* part 1:
 template <class RandomAccessIterator>
 inline bool operator == (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s)
-{ return m.str().compare(s) == 0; }
+{ return m.compare(s) == 0; }
 template <class RandomAccessIterator>
 inline bool operator != (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s)
-{ return m.str().compare(s) != 0; }
+{ return m.compare(s) != 0; }
 template <class RandomAccessIterator>
 inline bool operator > (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s)
-{ return m.str().compare(s) > 0; }
+{ return m.compare(s) > 0; }
 template <class RandomAccessIterator>
 inline bool operator < (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s)
-{ return m.str().compare(s) < 0; }
+{ return m.compare(s) < 0; }
 template <class RandomAccessIterator>
 inline bool operator >= (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s)
-{ return m.str().compare(s) >= 0; }
+{ return m.compare(s) >= 0; }
 template <class RandomAccessIterator>
 inline bool operator <= (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s)
-{ return m.str().compare(s) <= 0; }
+{ return m.compare(s) <= 0; }
 // comparison to const charT* part 2:
 template <class RandomAccessIterator>
 inline bool operator == (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(s) == 0; }
+{ return m.compare(s) == 0; }
 template <class RandomAccessIterator>
 inline bool operator != (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(s) != 0; }
+{ return m.compare(s) != 0; }
 template <class RandomAccessIterator>
 inline bool operator < (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(s) > 0; }
+{ return m.compare(s) > 0; }
 template <class RandomAccessIterator>
 inline bool operator > (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(s) < 0; }
+{ return m.compare(s) < 0; }
 template <class RandomAccessIterator>
 inline bool operator <= (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(s) >= 0; }
+{ return m.compare(s) >= 0; }
 template <class RandomAccessIterator>
 inline bool operator >= (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const* s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(s) <= 0; }
+{ return m.compare(s) <= 0; }
 
 // comparison to const charT& part 1:
 template <class RandomAccessIterator>
 inline bool operator == (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s)
-{ return m.str().compare(0, m.length(), &s, 1) == 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) == 0; }
 template <class RandomAccessIterator>
 inline bool operator != (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s)
-{ return m.str().compare(0, m.length(), &s, 1) != 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) != 0; }
 template <class RandomAccessIterator>
 inline bool operator > (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s)
-{ return m.str().compare(0, m.length(), &s, 1) > 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) > 0; }
 template <class RandomAccessIterator>
 inline bool operator < (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s)
-{ return m.str().compare(0, m.length(), &s, 1) < 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) < 0; }
 template <class RandomAccessIterator>
 inline bool operator >= (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s)
-{ return m.str().compare(0, m.length(), &s, 1) >= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) >= 0; }
 template <class RandomAccessIterator>
 inline bool operator <= (const sub_match<RandomAccessIterator>& m,
                   typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s)
-{ return m.str().compare(0, m.length(), &s, 1) <= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) <= 0; }
 // comparison to const charT* part 2:
 template <class RandomAccessIterator>
 inline bool operator == (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(0, m.length(), &s, 1) == 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) == 0; }
 template <class RandomAccessIterator>
 inline bool operator != (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(0, m.length(), &s, 1) != 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) != 0; }
 template <class RandomAccessIterator>
 inline bool operator < (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(0, m.length(), &s, 1) > 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) > 0; }
 template <class RandomAccessIterator>
 inline bool operator > (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(0, m.length(), &s, 1) < 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) < 0; }
 template <class RandomAccessIterator>
 inline bool operator <= (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(0, m.length(), &s, 1) >= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) >= 0; }
 template <class RandomAccessIterator>
 inline bool operator >= (typename BOOST_REGEX_DETAIL_NS::regex_iterator_traits<RandomAccessIterator>::value_type const& s,
                   const sub_match<RandomAccessIterator>& m)
-{ return m.str().compare(0, m.length(), &s, 1) <= 0; }
+{ return BOOST_REGEX_DETAIL_NS::compare_to_char(m, s) <= 0; }
 
 // addition operators:
 template <class RandomAccessIterator, class traits, class Allocator>
@@ -444,6 +556,16 @@ std::ostream& operator << (std::ostream& os,
 }
 #endif
 
+//
+// Hashing, consistent with the comparison operators: equal sub_match's have
+// the same hash value, whatever the positions of the characters they match:
+//
+template <class BidiIterator>
+inline std::size_t hash_value(const sub_match<BidiIterator>& m)
+{
+   return m.matched ? ::boost::hash_range(m.first, m.second) : 0;
+}
+
 #ifdef BOOST_OLD_REGEX_H
 namespace BOOST_REGEX_DETAIL_NS{
 template <class BidiIterator, class charT>
@@ -501,6 +623,21 @@ sub_match<BidiIterator>::operator unsigned int()const
 
 } // namespace boost
 
+#ifndef BOOST_NO_CXX11_HDR_FUNCTIONAL
+namespace std{
+
+template <class BidiIterator>
+struct hash< ::boost::sub_match<BidiIterator> >
+{
+   std::size_t operator()(const ::boost::sub_match<BidiIterator>& m)const
+   {
+      return ::boost::hash_value(m);
+   }
+};
+
+} // namespace std
+#endif
+
 #ifdef BOOST_MSVC
 #pragma warning(push)
 #pragma warning(disable: 4103)
@@ -14,16 +14,19 @@
 #include <boost/regex.hpp>
 #include <boost/filesystem.hpp>
 
-void load_file(std::string& text, const char* file)
+//
+// The search tests use files from a full Boost tree, when they're not present
+// those tests are skipped, see suite/benchmark.cpp for tests which generate
+// their own text:
+//
+bool load_file(std::string& text, const char* file)
 {
    std::deque<char> temp_copy;
    std::ifstream is(file);
    if(!is.good())
    {
-      std::string msg("Unable to open file: \"");
-      msg.append(file);
-      msg.append("\"");
-      throw std::runtime_error(msg);
+      std::cout << "Unable to open file: \"" << file << "\", skipping the searches which use it." << std::endl;
+      return false;
    }
    is.seekg(0, std::ios_base::end);
    std::istream::pos_type pos = is.tellg();
@@ -32,6 +35,7 @@ void load_file(std::string& text, const char* file)
    text.reserve(pos);
    std::istreambuf_iterator<char> it(is);
    std::copy(it, std::istreambuf_iterator<char>(), std::back_inserter(text));
+   return true;
 }
 
 
@@ -232,27 +236,34 @@ int cpp_main(int argc, char* argv[])
    const char* function_with_body_expression = "(\\w+)\\s*(\\([^()]++(?:(?2)[^()]++)*+[^)]*\\))\\s*(\\{[^{}]++((?3)[^{}]++)*+[^}]*+\\})";
 
 
-   load_file(file_contents, "../../../libs/libraries.htm");
-   test_search("Beman|John|Dave", file_contents.c_str(), false, "../../../libs/libraries.htm");
-   test_search("Beman|John|Dave", file_contents.c_str(), true, "../../../libs/libraries.htm");
-   test_search("(?i)<p>.*?</p>", file_contents.c_str(), true, "../../../libs/libraries.htm");
-   test_search("<a[^>]+href=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), false, "../../../libs/libraries.htm");
-   test_search("(?i)<a[^>]+href=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), true, "../../../libs/libraries.htm");
-   test_search("(?i)<h[12345678][^>]*>.*?</h[12345678]>", file_contents.c_str(), true, "../../../libs/libraries.htm");
-   test_search("<img[^>]+src=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), false, "../../../libs/libraries.htm");
-   test_search("(?i)<img[^>]+src=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), true, "../../../libs/libraries.htm");
-   test_search("(?i)<font[^>]+face=(\"[^\"]*\"|[^[:space:]]+)[^>]*>.*?</font>", file_contents.c_str(), true, "../../../libs/libraries.htm");
-
+   if(load_file(file_contents, "../../../libs/libraries.htm"))
+   {
+      test_search("Beman|John|Dave", file_contents.c_str(), false, "../../../libs/libraries.htm");
+      test_search("Beman|John|Dave", file_contents.c_str(), true, "../../../libs/libraries.htm");
+      test_search("(?i)<p>.*?</p>", file_contents.c_str(), true, "../../../libs/libraries.htm");
+      test_search("<a[^>]+href=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), false, "../../../libs/libraries.htm");
+      test_search("(?i)<a[^>]+href=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), true, "../../../libs/libraries.htm");
+      test_search("(?i)<h[12345678][^>]*>.*?</h[12345678]>", file_contents.c_str(), true, "../../../libs/libraries.htm");
+      test_search("<img[^>]+src=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), false, "../../../libs/libraries.htm");
+      test_search("(?i)<img[^>]+src=(\"[^\"]*\"|[^[:space:]]+)[^>]*>", file_contents.c_str(), true, "../../../libs/libraries.htm");
+      test_search("(?i)<font[^>]+face=(\"[^\"]*\"|[^[:space:]]+)[^>]*>.*?</font>", file_contents.c_str(), true, "../../../libs/libraries.htm");
+   }
 
-   load_file(file_contents, "../../../boost/multiprecision/number.hpp");
 
-   test_search(function_with_body_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
-   test_search(brace_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
-   test_search(call_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
-   test_search(highlight_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
-   test_search(class_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
-   test_search(include_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
-   test_search(boost_include_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+   if(load_file(file_contents, "../../../boost/multiprecision/number.hpp"))
+   {
+      test_search(function_with_body_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      test_search(brace_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      test_search(call_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      test_search(highlight_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      test_search(class_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      test_search(include_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      test_search(boost_include_expression, file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      // these spend most of their time stepping from one state to the next, so are
+      // a measure of the cost of dispatching each state in the matcher:
+      test_search("(\\w+)\\s*=\\s*(\\w+|[[:digit:]]+)\\s*;", file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+      test_search("\\<(?:if|else|for|while|return|template|typename)\\>\\s*[({<]?", file_contents.c_str(), true, "boost/multiprecision/number.hpp");
+   }
 
    return 0;
 }
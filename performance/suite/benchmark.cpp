@@ -0,0 +1,533 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2016 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+//  A self contained benchmark for Boost.Regex: searches generated
+//  text (see corpus.hpp) with each of the library's matching APIs,
+//  and reports throughput in MB/s and matches/s, optionally as JSON
+//  which a later run can be compared against with --baseline.
+//
+//  Usage: regex_benchmark [--size bytes] [--min-time seconds] [--repeats n]
+//                         [--filter regex] [--json file] [--baseline file]
+//                         [--tolerance fraction] [--list]
+//
+
+#include "corpus.hpp"
+#include <boost/regex.hpp>
+#include <boost/chrono.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/version.hpp>
+#include <boost/config.hpp>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <cstring>
+
+//
+// The APIs which are measured, each case lists those which make sense for it:
+//
+enum api_type
+{
+   api_match_lines = 1,      // regex_match on each line in turn
+   api_search_lines = 2,     // regex_search on each line in turn, as grep does
+   api_iterator = 4,         // regex_iterator over the whole text
+   api_token_iterator = 8,   // regex_token_iterator splitting the whole text
+   api_replace = 16,         // regex_replace over the whole text
+   api_count = 32,           // regex_count over the whole text
+   api_all_searches = api_search_lines | api_iterator | api_token_iterator | api_replace | api_count
+};
+
+static const char* const api_names[] = { "match", "search", "iterator", "token_iterator", "replace", "count" };
+static const unsigned api_total = sizeof(api_names) / sizeof(api_names[0]);
+
+//
+// The ways of running the matcher which are compared, every engine is
+// measured with regex_iterator, the other APIs with the default engine only:
+//
+struct engine_type
+{
+   const char* name;
+   boost::regex::flag_type syntax;
+   boost::match_flag_type flags;
+};
+
+static const engine_type engines[] =
+{
+   { "perl", boost::regex::perl, boost::match_default },
+   { "optimize", boost::regex::perl | boost::regex::optimize, boost::match_default },
+   { "nosubs", boost::regex::perl | boost::regex::nosubs, boost::match_default },
+   { "posix", boost::regex::perl, boost::match_posix },
+   { "memoize", boost::regex::perl, boost::match_memoize },
+};
+
+struct bench_case
+{
+   const char* name;
+   const char* corpus;
+   const char* expression;
+   unsigned apis;
+};
+
+static const bench_case cases[] =
+{
+   { "log_literal", "log", "timeout", api_all_searches },
+   { "log_level", "log", "\\b(?:ERROR|WARN)\\b", api_all_searches },
+   { "log_ip", "log", "\\b\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\b", api_all_searches },
+   { "log_request", "log", "\"(GET|POST|PUT|DELETE) (\\S+) HTTP/1\\.[01]\" (\\d{3}) (\\d+)ms", api_all_searches },
+   { "log_line", "log", "(?-s)(\\S+) (\\w+) \\[([^\\]]+)\\] (\\S+) \"([^\"]*)\" (\\d{3}) (\\d+)ms.*", api_match_lines | api_iterator },
+   { "log_error_line", "log", "(?-s)^\\S+ ERROR .*$", api_search_lines | api_iterator | api_count },
+   { "csv_field", "csv", "(?:\"(?:[^\"]|\"\")*\"|[^,\\n]*)(?:,|\\n)", api_iterator | api_count | api_replace },
+   { "csv_email", "csv", "[\\w.+-]+@[\\w-]+(?:\\.[\\w-]+)+", api_all_searches },
+   { "csv_amount", "csv", "-?\\d+\\.\\d{2}\\b", api_all_searches },
+   { "csv_row", "csv", "(\\d+),(\\w+),([^,]+),(-?\\d+\\.\\d\\d),(\\d{4}-\\d\\d-\\d\\d),(\"(?:[^\"]|\"\")*\"|[^,]*)", api_match_lines | api_iterator },
+   { "html_href", "html", "<a\\s+[^>]*href=\"([^\"]*)\"", api_all_searches },
+   { "html_tag", "html", "</?[[:alpha:]][[:alnum:]]*[^>]*>", api_all_searches },
+   { "html_para", "html", "(?i)<p>.*?</p>", api_iterator | api_count | api_replace },
+   { "html_heading", "html", "(?i)<h[1-6][^>]*>.*?</h[1-6]>", api_iterator | api_count },
+   { "utf8_word", "utf8", "\\w+", api_iterator | api_token_iterator | api_count },
+   { "utf8_multibyte", "utf8", "[\\xC0-\\xFF][\\x80-\\xBF]+", api_iterator | api_count | api_replace },
+   { "utf8_icase", "utf8", "(?i)stra\\xC3\\x9F" "e|caf\\xC3\\xA9|\\xC3\\xBC" "ber", api_search_lines | api_iterator | api_count },
+   { "utf8_sentence", "utf8", "[^.\\n]*\\xD0[^.\\n]*\\.", api_search_lines | api_iterator },
+   { "patho_alternation", "pathological", "(a|aa)+b", api_search_lines | api_iterator },
+   { "patho_nested", "pathological", "(\\w+\\s?)*!", api_search_lines | api_iterator },
+   { "patho_dot_star", "pathological", ".*zebra", api_search_lines | api_iterator },
+   { "patho_trailing_space", "pathological", "\\s+$", api_iterator | api_count },
+   { "patho_backref", "pathological", "\\b(\\w+)\\s+\\1\\b", api_search_lines | api_iterator },
+};
+
+struct options
+{
+   std::size_t size;
+   double min_time;
+   unsigned repeats;
+   boost::regex filter;
+   std::string json;
+   std::string baseline;
+   double tolerance;
+   bool list;
+   options() : size(1024 * 1024), min_time(0.1), repeats(3), tolerance(0.1), list(false) {}
+};
+
+struct result
+{
+   std::string case_name, corpus, expression, api, engine, status;
+   std::size_t bytes;
+   std::size_t matches;
+   double seconds;
+   double mb_per_s() const { return seconds > 0 ? bytes / seconds / 1e6 : 0; }
+   double matches_per_s() const { return seconds > 0 ? matches / seconds : 0; }
+};
+
+typedef std::pair<const char*, const char*> line_type;
+
+struct corpus_data
+{
+   std::string text;
+   std::vector<line_type> lines;
+};
+
+//
+// Stops the optimiser from throwing away work whose result is unused:
+//
+static std::size_t sink = 0;
+
+template <class Clock>
+struct stopwatch
+{
+   typedef typename Clock::duration duration;
+   stopwatch()
+   {
+      m_start = Clock::now();
+   }
+   duration elapsed()
+   {
+      return Clock::now() - m_start;
+   }
+private:
+   typename Clock::time_point m_start;
+};
+
+//
+// Runs f often enough to take at least min_time, and returns the best
+// time per call from several such runs:
+//
+template <class Func>
+double exec_timed_test(Func f, const options& opts, std::size_t& matches)
+{
+   double best = 0;
+   for(unsigned run = 0; run < opts.repeats; ++run)
+   {
+      double t = 0;
+      unsigned count = 1;
+      for(;;)
+      {
+         stopwatch<boost::chrono::high_resolution_clock> w;
+         for(unsigned i = 0; i < count; ++i)
+            matches = f();
+         t = boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+         if(t >= opts.min_time)
+            break;
+         count *= 2;
+      }
+      t /= count;
+      if((run == 0) || (t < best))
+         best = t;
+   }
+   return best;
+}
+
+std::size_t run_api(unsigned api, const corpus_data& data, const boost::regex& e, boost::match_flag_type flags)
+{
+   const char* first = data.text.c_str();
+   const char* last = first + data.text.size();
+   std::size_t matches = 0;
+   switch(api)
+   {
+   case api_match_lines:
+   case api_search_lines:
+      {
+         boost::cmatch what;
+         for(std::vector<line_type>::const_iterator i = data.lines.begin(); i != data.lines.end(); ++i)
+         {
+            if(api == api_match_lines ? boost::regex_match(i->first, i->second, what, e, flags)
+                                      : boost::regex_search(i->first, i->second, what, e, flags))
+               ++matches;
+         }
+      }
+      break;
+   case api_iterator:
+      {
+         boost::cregex_iterator i(first, last, e, flags), j;
+         for(; i != j; ++i)
+            ++matches;
+      }
+      break;
+   case api_token_iterator:
+      {
+         boost::cregex_token_iterator i(first, last, e, -1, flags), j;
+         for(; i != j; ++i)
+            ++matches;
+      }
+      break;
+   case api_replace:
+      {
+         std::string out;
+         out.reserve(data.text.size() * 2);
+         boost::regex_replace(std::back_inserter(out), first, last, e, "<$&>", flags);
+         // each match adds two characters:
+         matches = (out.size() - data.text.size()) / 2;
+      }
+      break;
+   case api_count:
+      matches = boost::regex_count(first, last, e, flags);
+      break;
+   }
+   sink += matches;
+   return matches;
+}
+
+const corpus_data& get_corpus(const std::string& name, std::size_t size)
+{
+   static std::map<std::string, corpus_data> cache;
+   std::map<std::string, corpus_data>::iterator pos = cache.find(name);
+   if(pos != cache.end())
+      return pos->second;
+   corpus_data& data = cache[name];
+   if(name == "log")
+      data.text = corpus::make_log(size);
+   else if(name == "csv")
+      data.text = corpus::make_csv(size);
+   else if(name == "html")
+      data.text = corpus::make_html(size);
+   else if(name == "utf8")
+      data.text = corpus::make_utf8(size);
+   else
+      data.text = corpus::make_pathological(size);
+   const char* p = data.text.c_str();
+   const char* end = p + data.text.size();
+   while(p != end)
+   {
+      const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+      if(!nl)
+         nl = end;
+      data.lines.push_back(line_type(p, nl));
+      p = nl == end ? end : nl + 1;
+   }
+   return data;
+}
+
+std::string json_string(const std::string& s)
+{
+   std::string result("\"");
+   for(std::string::const_iterator i = s.begin(); i != s.end(); ++i)
+   {
+      unsigned char c = static_cast<unsigned char>(*i);
+      if((c == '"') || (c == '\\'))
+      {
+         result += '\\';
+         result += *i;
+      }
+      else if((c < 0x20) || (c >= 0x7F))
+      {
+         char buf[8];
+         std::sprintf(buf, "\\u%04x", c);
+         result += buf;
+      }
+      else
+         result += *i;
+   }
+   result += '"';
+   return result;
+}
+
+std::string boost_name()
+{
+   return "boost " + boost::lexical_cast<std::string>(BOOST_VERSION / 100000) + "." + boost::lexical_cast<std::string>((BOOST_VERSION / 100) % 1000);
+}
+
+std::string matcher_name()
+{
+#ifdef BOOST_REGEX_RECURSIVE
+   return "recursive";
+#elif defined(BOOST_REGEX_HAS_COMPUTED_GOTO)
+   return "non-recursive, computed goto";
+#else
+   return "non-recursive, switch";
+#endif
+}
+
+//
+// Each result is written on a line of its own, so that read_baseline
+// below can find them again without a full JSON parser:
+//
+void write_json(std::ostream& os, const std::vector<result>& results, const options& opts)
+{
+   os << "{\n";
+   os << "  \"library\": " << json_string(boost_name()) << ",\n";
+   os << "  \"compiler\": " << json_string(BOOST_COMPILER) << ",\n";
+   os << "  \"platform\": " << json_string(BOOST_PLATFORM) << ",\n";
+   os << "  \"matcher\": " << json_string(matcher_name()) << ",\n";
+   os << "  \"corpus_size\": " << opts.size << ",\n";
+   os << "  \"results\": [\n";
+   for(std::vector<result>::const_iterator i = results.begin(); i != results.end(); ++i)
+   {
+      os << "    { \"case\": " << json_string(i->case_name)
+         << ", \"api\": " << json_string(i->api)
+         << ", \"engine\": " << json_string(i->engine)
+         << ", \"corpus\": " << json_string(i->corpus)
+         << ", \"expression\": " << json_string(i->expression)
+         << ", \"status\": " << json_string(i->status)
+         << ", \"bytes\": " << i->bytes
+         << ", \"matches\": " << i->matches
+         << ", \"seconds\": " << std::setprecision(6) << i->seconds
+         << ", \"mb_per_s\": " << std::setprecision(6) << i->mb_per_s()
+         << ", \"matches_per_s\": " << std::setprecision(6) << i->matches_per_s()
+         << " }" << (i + 1 == results.end() ? "\n" : ",\n");
+   }
+   os << "  ]\n}\n";
+}
+
+//
+// Returns a map from "case/api/engine" to MB/s for the results in a file
+// written by write_json, failed results are left out:
+//
+std::map<std::string, double> read_baseline(const std::string& file)
+{
+   static const boost::regex e("\"case\": \"([^\"]*)\", \"api\": \"([^\"]*)\", \"engine\": \"([^\"]*)\".*\"status\": \"ok\".*\"mb_per_s\": ([-+.0-9eE]+)");
+   std::map<std::string, double> result;
+   std::ifstream is(file.c_str());
+   if(!is.good())
+      throw std::runtime_error("Unable to open baseline file: \"" + file + "\"");
+   std::string line;
+   boost::smatch what;
+   while(std::getline(is, line))
+   {
+      if(boost::regex_search(line, what, e))
+         result[what.str(1) + "/" + what.str(2) + "/" + what.str(3)] = std::atof(what.str(4).c_str());
+   }
+   return result;
+}
+
+//
+// Prints each result which has changed by more than the tolerance, and
+// returns the number which got slower:
+//
+unsigned compare_with_baseline(const std::vector<result>& results, const options& opts)
+{
+   std::map<std::string, double> baseline = read_baseline(opts.baseline);
+   unsigned regressions = 0;
+   unsigned compared = 0;
+   std::cout << "\nComparison with " << opts.baseline << ":\n";
+   for(std::vector<result>::const_iterator i = results.begin(); i != results.end(); ++i)
+   {
+      std::map<std::string, double>::const_iterator pos = baseline.find(i->case_name + "/" + i->api + "/" + i->engine);
+      if((pos == baseline.end()) || (pos->second <= 0) || (i->status != "ok"))
+         continue;
+      ++compared;
+      double ratio = i->mb_per_s() / pos->second;
+      if(ratio < 1 - opts.tolerance)
+         ++regressions;
+      if((ratio < 1 - opts.tolerance) || (ratio > 1 + opts.tolerance))
+      {
+         std::cout << std::left << std::setw(24) << i->case_name << std::setw(16) << i->api << std::setw(10) << i->engine
+            << std::right << std::fixed << std::setprecision(1) << std::setw(10) << pos->second << " -> "
+            << std::setw(10) << i->mb_per_s() << " MB/s (" << std::showpos << (ratio - 1) * 100 << std::noshowpos << "%)"
+            << (ratio < 1 ? " SLOWER" : " faster") << std::endl;
+      }
+   }
+   std::cout << compared << " results compared, " << regressions << " slower by more than "
+      << std::setprecision(0) << opts.tolerance * 100 << "%" << std::endl;
+   return regressions;
+}
+
+void usage()
+{
+   std::cerr <<
+      "Usage: regex_benchmark [options]\n"
+      "  --size bytes           size of each generated corpus (default 1048576)\n"
+      "  --min-time seconds     shortest time for each measurement (default 0.1)\n"
+      "  --repeats n            measurements taken, the best is kept (default 3)\n"
+      "  --filter regex         only run tests whose corpus/case/api/engine matches\n"
+      "  --json file            write the results to file as JSON\n"
+      "  --baseline file        compare with the JSON written by an earlier run,\n"
+      "                         the exit code is non-zero if anything is slower\n"
+      "  --tolerance fraction   change in MB/s ignored by --baseline (default 0.1)\n"
+      "  --list                 list the tests without running them\n";
+}
+
+bool parse_options(int argc, char* argv[], options& opts)
+{
+   for(int i = 1; i < argc; ++i)
+   {
+      std::string arg(argv[i]);
+      if(arg == "--list")
+      {
+         opts.list = true;
+         continue;
+      }
+      if(i + 1 == argc)
+         return false;
+      std::string value(argv[++i]);
+      if(arg == "--size")
+         opts.size = boost::lexical_cast<std::size_t>(value);
+      else if(arg == "--min-time")
+         opts.min_time = boost::lexical_cast<double>(value);
+      else if(arg == "--repeats")
+         opts.repeats = (std::max)(1u, boost::lexical_cast<unsigned>(value));
+      else if(arg == "--filter")
+         opts.filter.assign(value);
+      else if(arg == "--json")
+         opts.json = value;
+      else if(arg == "--baseline")
+         opts.baseline = value;
+      else if(arg == "--tolerance")
+         opts.tolerance = boost::lexical_cast<double>(value);
+      else
+         return false;
+   }
+   return true;
+}
+
+int main(int argc, char* argv[])
+{
+   options opts;
+   try{
+      if(!parse_options(argc, argv, opts))
+      {
+         usage();
+         return 2;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      std::cerr << "Invalid argument: " << e.what() << std::endl;
+      usage();
+      return 2;
+   }
+
+   std::cout << boost_name() << ", " << BOOST_COMPILER << ", " << BOOST_PLATFORM << ", " << matcher_name() << " matcher\n";
+   std::cout << std::left << std::setw(24) << "case" << std::setw(16) << "api" << std::setw(10) << "engine"
+      << std::right << std::setw(12) << "MB/s" << std::setw(14) << "matches/s" << std::setw(10) << "matches" << std::endl;
+
+   std::vector<result> results;
+   for(unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+   {
+      for(unsigned a = 0; a < api_total; ++a)
+      {
+         unsigned api = 1u << a;
+         if(!(cases[c].apis & api))
+            continue;
+         for(unsigned n = 0; n < sizeof(engines) / sizeof(engines[0]); ++n)
+         {
+            if(n && (api != api_iterator))
+               continue;
+            std::string id = std::string(cases[c].corpus) + "/" + cases[c].name + "/" + api_names[a] + "/" + engines[n].name;
+            if(!opts.filter.empty() && !boost::regex_search(id, opts.filter))
+               continue;
+            if(opts.list)
+            {
+               std::cout << id << "\n";
+               continue;
+            }
+            result r;
+            r.case_name = cases[c].name;
+            r.corpus = cases[c].corpus;
+            r.expression = cases[c].expression;
+            r.api = api_names[a];
+            r.engine = engines[n].name;
+            r.matches = 0;
+            r.seconds = 0;
+            const corpus_data& data = get_corpus(r.corpus, opts.size);
+            r.bytes = data.text.size();
+            try{
+               boost::regex e(cases[c].expression, engines[n].syntax);
+               boost::match_flag_type flags = engines[n].flags;
+               r.seconds = exec_timed_test([&]() { return run_api(api, data, e, flags); }, opts, r.matches);
+               r.status = "ok";
+            }
+            catch(const std::exception& e)
+            {
+               // pathological cases are expected to fail with some engines:
+               r.status = e.what();
+            }
+            std::cout << std::left << std::setw(24) << r.case_name << std::setw(16) << r.api << std::setw(10) << r.engine << std::right;
+            if(r.status == "ok")
+               std::cout << std::fixed << std::setprecision(1) << std::setw(12) << r.mb_per_s()
+                  << std::setprecision(0) << std::setw(14) << r.matches_per_s() << std::setw(10) << r.matches << std::endl;
+            else
+               std::cout << "  failed: " << r.status.substr(0, r.status.find('.')) << std::endl;
+            results.push_back(r);
+         }
+      }
+   }
+   if(opts.list)
+      return 0;
+
+   if(!opts.json.empty())
+   {
+      std::ofstream os(opts.json.c_str());
+      write_json(os, results, opts);
+      if(!os.good())
+      {
+         std::cerr << "Unable to write results to \"" << opts.json << "\"" << std::endl;
+         return 1;
+      }
+   }
+   if(!opts.baseline.empty())
+   {
+      try{
+         return compare_with_baseline(results, opts) ? 1 : 0;
+      }
+      catch(const std::exception& e)
+      {
+         std::cerr << e.what() << std::endl;
+         return 2;
+      }
+   }
+   return 0;
+}
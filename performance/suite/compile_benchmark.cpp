@@ -0,0 +1,293 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2016 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+//  Measures how long Boost.Regex takes to compile expressions:
+//  each case generates a list of patterns from a fixed seed (see
+//  corpus.hpp) and constructs a basic_regex from every one in turn,
+//  the cases with a single pattern build one large alternation.
+//
+//  Usage: regex_compile_benchmark [--count n] [--min-time seconds]
+//                                 [--repeats n] [--filter regex]
+//
+
+#include "corpus.hpp"
+#include <boost/regex.hpp>
+#include <boost/chrono.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/config.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+typedef std::vector<std::string> pattern_list;
+
+struct options
+{
+   unsigned count;
+   double min_time;
+   unsigned repeats;
+   boost::regex filter;
+   options() : count(20000), min_time(0.2), repeats(3) {}
+};
+
+//
+// The pattern generators, each is passed the number of patterns wanted
+// and returns them:
+//
+void append_word_number(corpus::generator& g, std::string& s)
+{
+   s += g.pick(corpus::words);
+   g.append_number(s, g.below(100000));
+}
+
+pattern_list make_literals(unsigned n)
+{
+   corpus::generator g(11);
+   pattern_list result;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      std::string s;
+      corpus::append_words(g, s, 1 + g.below(3));
+      s += ' ';
+      append_word_number(g, s);
+      result.push_back(s);
+   }
+   return result;
+}
+
+pattern_list make_log_patterns(unsigned n)
+{
+   static const char* const shapes[] =
+   {
+      "\\b(?:%|%)\\b",
+      "^\\S+ % \\[([^\\]]+)\\] (\\d{1,3}(?:\\.\\d{1,3}){3})",
+      "\"(GET|POST) /%/(\\d+) HTTP/1\\.[01]\" (\\d{3})",
+      "user=(\\w+)@%\\.(?:com|org|net)",
+      "(\\d{4})-(\\d\\d)-(\\d\\d)T.*%",
+      "%\\s*=\\s*\"([^\"]*)\"",
+      "[[:alpha:]_][[:alnum:]_]*::%",
+      "(?i)%\\s+(?:error|warning)s?",
+   };
+   corpus::generator g(12);
+   pattern_list result;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      std::string s;
+      for(const char* p = g.pick(shapes); *p; ++p)
+      {
+         if(*p == '%')
+            append_word_number(g, s);
+         else
+            s += *p;
+      }
+      result.push_back(s);
+   }
+   return result;
+}
+
+pattern_list make_sets(unsigned n)
+{
+   static const char* const sets[] =
+   {
+      "[a-z]", "[A-Za-z0-9_]", "[^,\\n]", "[[:space:][:punct:]]", "[\\w.+-]", "[^\"\\\\]", "[0-9a-fA-F]", "[[:upper:]]",
+   };
+   static const char* const repeats[] = { "", "*", "+", "?", "{2,4}" };
+   corpus::generator g(13);
+   pattern_list result;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      std::string s;
+      unsigned parts = 2 + g.below(4);
+      for(unsigned j = 0; j < parts; ++j)
+      {
+         s += g.pick(sets);
+         s += g.pick(repeats);
+      }
+      s += g.pick(corpus::words);
+      result.push_back(s);
+   }
+   return result;
+}
+
+pattern_list make_alternation(unsigned n, bool icase)
+{
+   corpus::generator g(14);
+   std::string s(icase ? "(?i)(?:" : "(?:");
+   for(unsigned i = 0; i < n; ++i)
+   {
+      if(i)
+         s += '|';
+      append_word_number(g, s);
+      s += '.';
+      s += g.pick(corpus::domains);
+   }
+   s += ")";
+   return pattern_list(1, s);
+}
+
+pattern_list make_host_list(unsigned n)
+{
+   return make_alternation(n, false);
+}
+
+pattern_list make_icase_host_list(unsigned n)
+{
+   return make_alternation(n, true);
+}
+
+struct bench_case
+{
+   const char* name;
+   pattern_list (*make)(unsigned);
+   boost::regex::flag_type flags;
+};
+
+static const bench_case cases[] =
+{
+   { "literals", &make_literals, boost::regex::perl },
+   { "literals_icase", &make_literals, boost::regex::perl | boost::regex::icase },
+   { "log_patterns", &make_log_patterns, boost::regex::perl },
+   { "log_patterns_nosubs", &make_log_patterns, boost::regex::perl | boost::regex::nosubs },
+   { "log_patterns_optimize", &make_log_patterns, boost::regex::perl | boost::regex::optimize },
+   { "sets", &make_sets, boost::regex::perl },
+   { "host_alternation", &make_host_list, boost::regex::perl },
+   { "host_alternation_icase", &make_icase_host_list, boost::regex::perl },
+};
+
+template <class Clock>
+struct stopwatch
+{
+   typedef typename Clock::duration duration;
+   stopwatch()
+   {
+      m_start = Clock::now();
+   }
+   duration elapsed()
+   {
+      return Clock::now() - m_start;
+   }
+private:
+   typename Clock::time_point m_start;
+};
+
+//
+// Stops the optimiser from throwing away work whose result is unused:
+//
+static std::size_t sink = 0;
+
+void compile_all(const pattern_list& patterns, boost::regex::flag_type flags)
+{
+   for(pattern_list::const_iterator i = patterns.begin(); i != patterns.end(); ++i)
+   {
+      boost::regex e(*i, flags);
+      sink += e.size();
+   }
+}
+
+//
+// Compiles the patterns often enough to take at least min_time, and
+// returns the best time for one pass from several such runs:
+//
+double time_compile(const pattern_list& patterns, boost::regex::flag_type flags, const options& opts)
+{
+   double best = 0;
+   for(unsigned run = 0; run < opts.repeats; ++run)
+   {
+      double t = 0;
+      unsigned count = 1;
+      for(;;)
+      {
+         stopwatch<boost::chrono::high_resolution_clock> w;
+         for(unsigned i = 0; i < count; ++i)
+            compile_all(patterns, flags);
+         t = boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+         if(t >= opts.min_time)
+            break;
+         count *= 2;
+      }
+      t /= count;
+      if((run == 0) || (t < best))
+         best = t;
+   }
+   return best;
+}
+
+void usage()
+{
+   std::cerr <<
+      "Usage: regex_compile_benchmark [options]\n"
+      "  --count n              patterns generated for each case, or the number of\n"
+      "                         alternatives in the single pattern ones (default 20000)\n"
+      "  --min-time seconds     shortest time for each measurement (default 0.2)\n"
+      "  --repeats n            measurements taken, the best is kept (default 3)\n"
+      "  --filter regex         only run the cases whose name matches\n";
+}
+
+bool parse_options(int argc, char* argv[], options& opts)
+{
+   for(int i = 1; i < argc; ++i)
+   {
+      if(i + 1 == argc)
+         return false;
+      std::string arg(argv[i]);
+      std::string value(argv[++i]);
+      if(arg == "--count")
+         opts.count = (std::max)(1u, boost::lexical_cast<unsigned>(value));
+      else if(arg == "--min-time")
+         opts.min_time = boost::lexical_cast<double>(value);
+      else if(arg == "--repeats")
+         opts.repeats = (std::max)(1u, boost::lexical_cast<unsigned>(value));
+      else if(arg == "--filter")
+         opts.filter.assign(value);
+      else
+         return false;
+   }
+   return true;
+}
+
+int main(int argc, char* argv[])
+{
+   options opts;
+   try{
+      if(!parse_options(argc, argv, opts))
+      {
+         usage();
+         return 2;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      std::cerr << "Invalid argument: " << e.what() << std::endl;
+      usage();
+      return 2;
+   }
+
+   std::cout << BOOST_COMPILER << ", " << BOOST_PLATFORM << "\n";
+   std::cout << std::left << std::setw(26) << "case" << std::right << std::setw(10) << "patterns"
+      << std::setw(14) << "bytes" << std::setw(12) << "total ms" << std::setw(14) << "us/pattern" << std::setw(10) << "MB/s" << std::endl;
+
+   for(unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+   {
+      if(!opts.filter.empty() && !boost::regex_search(cases[c].name, opts.filter))
+         continue;
+      pattern_list patterns = cases[c].make(opts.count);
+      std::size_t bytes = 0;
+      for(pattern_list::const_iterator i = patterns.begin(); i != patterns.end(); ++i)
+         bytes += i->size();
+      std::cout << std::left << std::setw(26) << cases[c].name << std::right << std::setw(10) << patterns.size() << std::setw(14) << bytes;
+      try{
+         double t = time_compile(patterns, cases[c].flags, opts);
+         std::cout << std::fixed << std::setprecision(2) << std::setw(12) << t * 1000
+            << std::setw(14) << t * 1e6 / patterns.size()
+            << std::setprecision(1) << std::setw(10) << bytes / t / 1e6 << std::endl;
+      }
+      catch(const std::exception& e)
+      {
+         std::cout << "  failed: " << e.what() << std::endl;
+      }
+   }
+   return sink ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2016 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+//  Generates the text searched by the benchmark suite: every corpus
+//  is built from a fixed seed, so that the same size always produces
+//  the same bytes, on every platform, and results from different
+//  builds can be compared with each other.
+//
+
+#ifndef BOOST_REGEX_BENCHMARK_CORPUS_HPP
+#define BOOST_REGEX_BENCHMARK_CORPUS_HPP
+
+#include <string>
+#include <cstdio>
+#include <boost/cstdint.hpp>
+
+namespace corpus{
+
+//
+// A small linear congruential generator, std::rand and the <random>
+// distributions are not guaranteed to give the same sequence everywhere:
+//
+class generator
+{
+public:
+   explicit generator(boost::uint32_t seed) : m_state(seed) {}
+   boost::uint32_t next()
+   {
+      m_state = m_state * 1664525u + 1013904223u;
+      return m_state >> 8;
+   }
+   // a value in [0, n):
+   unsigned below(unsigned n)
+   {
+      return next() % n;
+   }
+   template <std::size_t N>
+   const char* pick(const char* const (&a)[N])
+   {
+      return a[below(N)];
+   }
+   void append_number(std::string& s, unsigned n, unsigned width = 0)
+   {
+      char buf[32];
+      std::sprintf(buf, "%0*u", static_cast<int>(width), n);
+      s.append(buf);
+   }
+private:
+   boost::uint32_t m_state;
+};
+
+static const char* const words[] =
+{
+   "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "regular", "expression",
+   "match", "search", "replace", "iterator", "boost", "library", "function", "template", "value", "result",
+   "error", "warning", "request", "response", "server", "client", "timeout", "connection", "buffer", "stream",
+   "alpha", "beta", "gamma", "delta", "index", "table", "record", "field", "header", "footer",
+};
+
+static const char* const first_names[] =
+{
+   "alice", "bob", "carol", "dave", "erin", "frank", "grace", "heidi", "ivan", "judy", "mallory", "oscar",
+};
+
+static const char* const domains[] =
+{
+   "example.com", "example.org", "mail.example.net", "boost.org", "test.co.uk",
+};
+
+inline void append_words(generator& g, std::string& s, unsigned n)
+{
+   for(unsigned i = 0; i < n; ++i)
+   {
+      if(i)
+         s += ' ';
+      s += g.pick(words);
+   }
+}
+
+//
+// Web server style log lines:
+// 2016-03-14T12:34:56.789Z INFO [worker-3] 10.0.3.7 "GET /api/v1/items/1234 HTTP/1.1" 200 532ms user=alice@example.com
+//
+inline std::string make_log(std::size_t size)
+{
+   static const char* const levels[] = { "INFO", "INFO", "INFO", "INFO", "DEBUG", "DEBUG", "WARN", "ERROR" };
+   static const char* const methods[] = { "GET", "GET", "GET", "POST", "PUT", "DELETE" };
+   static const char* const paths[] = { "/api/v1/items/", "/api/v1/users/", "/static/img/", "/search?q=", "/login" };
+   static const unsigned codes[] = { 200, 200, 200, 200, 201, 204, 301, 304, 404, 500 };
+   generator g(1);
+   std::string s;
+   s.reserve(size + 256);
+   while(s.size() < size)
+   {
+      s += "2016-";
+      g.append_number(s, 1 + g.below(12), 2);
+      s += '-';
+      g.append_number(s, 1 + g.below(28), 2);
+      s += 'T';
+      g.append_number(s, g.below(24), 2);
+      s += ':';
+      g.append_number(s, g.below(60), 2);
+      s += ':';
+      g.append_number(s, g.below(60), 2);
+      s += '.';
+      g.append_number(s, g.below(1000), 3);
+      s += "Z ";
+      s += g.pick(levels);
+      s += " [worker-";
+      g.append_number(s, g.below(16));
+      s += "] ";
+      g.append_number(s, 10);
+      s += '.';
+      g.append_number(s, g.below(256));
+      s += '.';
+      g.append_number(s, g.below(256));
+      s += '.';
+      g.append_number(s, g.below(256));
+      s += " \"";
+      s += g.pick(methods);
+      s += ' ';
+      s += g.pick(paths);
+      g.append_number(s, g.below(100000));
+      s += " HTTP/1.1\" ";
+      g.append_number(s, codes[g.below(sizeof(codes) / sizeof(codes[0]))]);
+      s += ' ';
+      g.append_number(s, g.below(5000));
+      s += "ms";
+      if(g.below(3) == 0)
+      {
+         s += " user=";
+         s += g.pick(first_names);
+         s += '@';
+         s += g.pick(domains);
+      }
+      if(g.below(4) == 0)
+      {
+         s += " msg=\"";
+         append_words(g, s, 2 + g.below(8));
+         s += '"';
+      }
+      s += '\n';
+   }
+   return s;
+}
+
+//
+// Comma separated values, with a header row, quoted fields and embedded quotes:
+//
+inline std::string make_csv(std::size_t size)
+{
+   generator g(2);
+   std::string s("id,name,email,amount,date,comment\n");
+   s.reserve(size + 256);
+   for(unsigned id = 1; s.size() < size; ++id)
+   {
+      g.append_number(s, id);
+      s += ',';
+      const char* name = g.pick(first_names);
+      s += name;
+      s += ',';
+      s += name;
+      if(g.below(2))
+      {
+         s += '.';
+         s += g.pick(words);
+      }
+      s += '@';
+      s += g.pick(domains);
+      s += ',';
+      if(g.below(5) == 0)
+         s += '-';
+      g.append_number(s, g.below(100000));
+      s += '.';
+      g.append_number(s, g.below(100), 2);
+      s += ",2016-";
+      g.append_number(s, 1 + g.below(12), 2);
+      s += '-';
+      g.append_number(s, 1 + g.below(28), 2);
+      s += ',';
+      switch(g.below(3))
+      {
+      case 0:
+         break;
+      case 1:
+         append_words(g, s, 1 + g.below(4));
+         break;
+      default:
+         s += '"';
+         append_words(g, s, 1 + g.below(3));
+         s += ", \"\"";
+         s += g.pick(words);
+         s += "\"\" ";
+         append_words(g, s, 1 + g.below(3));
+         s += '"';
+      }
+      s += '\n';
+   }
+   return s;
+}
+
+//
+// HTML with nested elements, links, images and mixed case tags:
+//
+inline std::string make_html(std::size_t size)
+{
+   static const char* const headings[] = { "h1", "h2", "h3", "H2" };
+   generator g(3);
+   std::string s("<!DOCTYPE html>\n<html>\n<head><title>Generated document</title></head>\n<body>\n");
+   s.reserve(size + 512);
+   while(s.size() < size)
+   {
+      const char* h = g.pick(headings);
+      s += '<';
+      s += h;
+      s += " class=\"title\">";
+      append_words(g, s, 1 + g.below(4));
+      s += "</";
+      s += h;
+      s += ">\n";
+      for(unsigned p = 1 + g.below(4); p; --p)
+      {
+         s += g.below(4) ? "<p>" : "<P>";
+         for(unsigned sentence = 1 + g.below(4); sentence; --sentence)
+         {
+            append_words(g, s, 3 + g.below(10));
+            switch(g.below(6))
+            {
+            case 0:
+               s += " <a href=\"http://www.";
+               s += g.pick(domains);
+               s += '/';
+               s += g.pick(words);
+               s += ".html\">";
+               append_words(g, s, 1 + g.below(3));
+               s += "</a>";
+               break;
+            case 1:
+               s += " <img src=\"images/";
+               s += g.pick(words);
+               s += ".png\" alt=\"";
+               s += g.pick(words);
+               s += "\">";
+               break;
+            case 2:
+               s += " <b>";
+               s += g.pick(words);
+               s += "</b>";
+               break;
+            default:
+               break;
+            }
+            s += ".\n";
+         }
+         s += "</p>\n";
+      }
+      if(g.below(5) == 0)
+      {
+         s += "<ul>\n";
+         for(unsigned li = 1 + g.below(5); li; --li)
+         {
+            s += "  <li><a href=\"#";
+            s += g.pick(words);
+            s += "\">";
+            s += g.pick(words);
+            s += "</a></li>\n";
+         }
+         s += "</ul>\n";
+      }
+   }
+   s += "</body>\n</html>\n";
+   return s;
+}
+
+//
+// UTF-8 encoded prose, mostly Latin-1 supplement with some Cyrillic,
+// Greek and CJK, searched as narrow characters:
+//
+inline std::string make_utf8(std::size_t size)
+{
+   static const char* const utf8_words[] =
+   {
+      "stra\xC3\x9F" "e", "\xC3\xBC" "ber", "caf\xC3\xA9", "na\xC3\xAF" "ve", "se\xC3\xB1or", "fa\xC3\xA7" "ade",
+      "\xC3\x85ngstr\xC3\xB6m", "\xD0\xBC\xD0\xB8\xD1\x80", "\xD0\x9C\xD0\xBE\xD1\x81\xD0\xBA\xD0\xB2\xD0\xB0",
+      "\xCE\xB1\xCE\xBB\xCF\x86\xCE\xB1", "\xCE\xA3\xCE\xBF\xCF\x86\xCE\xAF\xCE\xB1",
+      "\xE6\x97\xA5\xE6\x9C\xAC", "\xE4\xB8\xAD\xE6\x96\x87", "\xED\x95\x9C\xEA\xB5\xAD\xEC\x96\xB4",
+      "\xF0\x9F\x98\x80",
+   };
+   generator g(4);
+   std::string s;
+   s.reserve(size + 256);
+   while(s.size() < size)
+   {
+      for(unsigned w = 5 + g.below(15); w; --w)
+      {
+         s += g.below(3) ? g.pick(words) : g.pick(utf8_words);
+         s += w == 1 ? ".\n" : " ";
+      }
+   }
+   return s;
+}
+
+//
+// Text built to provoke worst case behaviour: long runs of a single
+// character with no terminator, and long lines of words with nothing
+// to stop a nested repeat:
+//
+inline std::string make_pathological(std::size_t size)
+{
+   generator g(5);
+   std::string s;
+   s.reserve(size + 256);
+   while(s.size() < size)
+   {
+      switch(g.below(3))
+      {
+      case 0:
+         s.append(10 + g.below(15), 'a');
+         break;
+      case 1:
+         append_words(g, s, 10 + g.below(30));
+         break;
+      default:
+         s.append(20 + g.below(60), ' ');
+         s += g.pick(words);
+      }
+      s += '\n';
+   }
+   return s;
+}
+
+} // namespace corpus
+
+#endif
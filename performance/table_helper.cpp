@@ -352,7 +352,11 @@ void report_execution_time(double t, std::string table, std::string row, std::st
 
 std::string boost_name()
 {
-   return "boost " + boost::lexical_cast<std::string>(BOOST_VERSION / 100000) + "." + boost::lexical_cast<std::string>((BOOST_VERSION / 100) % 1000);
+   std::string result = "boost " + boost::lexical_cast<std::string>(BOOST_VERSION / 100000) + "." + boost::lexical_cast<std::string>((BOOST_VERSION / 100) % 1000);
+#ifdef BOOST_REGEX_NO_COMPUTED_GOTO
+   result += " (switch dispatch)";
+#endif
+   return result;
 }
 
 std::string compiler_name()
@@ -140,6 +140,15 @@ void RegExData::clean()
 #endif
 }
 
+class RegExMatchData
+{
+public:
+   cmatch m;
+   const char* pbase;
+   std::size_t marks;
+   RegExMatchData() : m(), pbase(0), marks(0) {}
+};
+
 } // namespace
 
 RegEx::RegEx()
@@ -230,6 +239,26 @@ bool RegEx::Search(const char* p, match_flag_type flags)
    }
    return false;
 }
+bool RegEx::Match(const char* p, RegExMatch& what, match_flag_type flags)const
+{
+   what.pdata->pbase = p;
+   what.pdata->marks = pdata->e.mark_count();
+   const char* end = p;
+   while(*end)++end;
+
+   return regex_match(p, end, what.pdata->m, pdata->e, flags);
+}
+
+bool RegEx::Search(const char* p, RegExMatch& what, match_flag_type flags)const
+{
+   what.pdata->pbase = p;
+   what.pdata->marks = pdata->e.mark_count();
+   const char* end = p;
+   while(*end)++end;
+
+   return regex_search(p, end, what.pdata->m, pdata->e, flags);
+}
+
 namespace BOOST_REGEX_DETAIL_NS{
 struct pred1
 {
@@ -456,7 +485,7 @@ unsigned int RegEx::FindFiles(FindFilesCallback cb, const char* files, bool recu
 #endif
 
 std::string RegEx::Merge(const std::string& in, const std::string& fmt,
-                    bool copy, match_flag_type flags)
+                    bool copy, match_flag_type flags)const
 {
    std::string result;
    BOOST_REGEX_DETAIL_NS::string_out_iterator<std::string> i(result);
@@ -466,7 +495,7 @@ std::string RegEx::Merge(const std::string& in, const std::string& fmt,
 }
 
 std::string RegEx::Merge(const char* in, const char* fmt,
-                    bool copy, match_flag_type flags)
+                    bool copy, match_flag_type flags)const
 {
    std::string result;
    if(!copy) flags |= format_no_copy;
@@ -478,7 +507,7 @@ std::string RegEx::Merge(const char* in, const char* fmt,
 std::size_t RegEx::Split(std::vector<std::string>& v, 
                       std::string& s,
                       match_flag_type flags,
-                      unsigned max_count)
+                      unsigned max_count)const
 {
    return regex_split(std::back_inserter(v), s, pdata->e, flags, max_count);
 }
@@ -584,6 +613,60 @@ std::string RegEx::What(int i)const
 
 const std::size_t RegEx::npos = ~static_cast<std::size_t>(0);
 
+RegExMatch::RegExMatch()
+{
+   pdata = new BOOST_REGEX_DETAIL_NS::RegExMatchData();
+}
+
+RegExMatch::RegExMatch(const RegExMatch& o)
+{
+   pdata = new BOOST_REGEX_DETAIL_NS::RegExMatchData(*(o.pdata));
+}
+
+RegExMatch::~RegExMatch()
+{
+   delete pdata;
+}
+
+RegExMatch& RegExMatch::operator=(const RegExMatch& o)
+{
+   *pdata = *(o.pdata);
+   return *this;
+}
+
+std::size_t RegExMatch::Position(int i)const
+{
+   if(pdata->m.empty())
+      return RegEx::npos;
+   return pdata->m[i].matched ? pdata->m[i].first - pdata->pbase : RegEx::npos;
+}
+
+std::size_t RegExMatch::Length(int i)const
+{
+   if(pdata->m.empty())
+      return RegEx::npos;
+   return pdata->m[i].matched ? pdata->m[i].second - pdata->m[i].first : RegEx::npos;
+}
+
+bool RegExMatch::Matched(int i)const
+{
+   return !pdata->m.empty() && pdata->m[i].matched;
+}
+
+std::size_t RegExMatch::Marks()const
+{
+   // the same as RegEx::Marks() for the expression last used, matched or not:
+   return pdata->marks;
+}
+
+std::string RegExMatch::What(int i)const
+{
+   std::string result;
+   if(!pdata->m.empty() && pdata->m[i].matched)
+      result.assign(pdata->m[i].first, pdata->m[i].second);
+   return result;
+}
+
 } // namespace boost
 
 #if defined(__BORLANDC__) && (__BORLANDC__ >= 0x550) && (__BORLANDC__ <= 0x551) && !defined(_RWSTD_COMPILE_INSTANTIATE)
@@ -32,4 +32,107 @@ enum
    char_class_vertical=1<<13
 };
 
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <boost/throw_exception.hpp>
+
+namespace boost{
+namespace BOOST_REGEX_DETAIL_NS{
+//
+// The results of a call to regexec are only needed until they've been
+// copied to the caller's array, so they're allocated from a small buffer
+// on the stack, the heap is only used once that has been used up:
+//
+class local_buffer
+{
+public:
+   local_buffer() : m_used(0) {}
+   void* allocate(std::size_t n)
+   {
+      n = (n + sizeof(m_data.align) - 1) / sizeof(m_data.align) * sizeof(m_data.align);
+      if(n > sizeof(m_data.bytes) - m_used)
+         return ::operator new(n);
+      void* result = m_data.bytes + m_used;
+      m_used += n;
+      return result;
+   }
+   void deallocate(void* p)
+   {
+      // memory within the buffer is only reclaimed when the buffer goes:
+      if((static_cast<char*>(p) < m_data.bytes) || (static_cast<char*>(p) >= m_data.bytes + sizeof(m_data.bytes)))
+         ::operator delete(p);
+   }
+private:
+   local_buffer(const local_buffer&);
+   local_buffer& operator=(const local_buffer&);
+   union
+   {
+      char bytes[512];
+      double align;
+   } m_data;
+   std::size_t m_used;
+};
+
+template <class T>
+class local_allocator
+{
+public:
+   typedef T value_type;
+   typedef T* pointer;
+   typedef const T* const_pointer;
+   typedef T& reference;
+   typedef const T& const_reference;
+   typedef std::size_t size_type;
+   typedef std::ptrdiff_t difference_type;
+   template <class U>
+   struct rebind
+   {
+      typedef local_allocator<U> other;
+   };
+
+   explicit local_allocator(local_buffer& b) : m_buffer(&b) {}
+   template <class U>
+   local_allocator(const local_allocator<U>& a) : m_buffer(a.buffer()) {}
+
+   pointer address(reference x)const { return &x; }
+   const_pointer address(const_reference x)const { return &x; }
+   pointer allocate(size_type n, const void* = 0)
+   {
+      if(n > max_size())
+         boost::throw_exception(std::bad_alloc());
+      return static_cast<pointer>(m_buffer->allocate(n * sizeof(T)));
+   }
+   void deallocate(pointer p, size_type)
+   {
+      m_buffer->deallocate(p);
+   }
+   size_type max_size()const
+   {
+      return (std::numeric_limits<size_type>::max)() / sizeof(T);
+   }
+   void construct(pointer p, const T& val)
+   {
+      new (static_cast<void*>(p)) T(val);
+   }
+   void destroy(pointer p)
+   {
+      p->~T();
+   }
+   local_buffer* buffer()const { return m_buffer; }
+   template <class U>
+   bool operator==(const local_allocator<U>& a)const { return m_buffer == a.buffer(); }
+   template <class U>
+   bool operator!=(const local_allocator<U>& a)const { return m_buffer != a.buffer(); }
+private:
+   local_buffer* m_buffer;
+};
+
+} // namespace BOOST_REGEX_DETAIL_NS
+} // namespace boost
+
+#endif
+
 #endif // BOOST_REGEX_SRC_INTERNALS_HPP
@@ -23,6 +23,7 @@
 #include <cstring>
 #include <boost/regex.hpp>
 #include <boost/cregex.hpp>
+#include "internals.hpp"
 
 #if defined(BOOST_NO_STDC_NAMESPACE)
 namespace std{
@@ -222,7 +223,9 @@ BOOST_REGEX_DECL int BOOST_REGEX_CCALL regexecA(const regex_tA* expression, cons
    match_flag_type flags = match_default | expression->eflags;
    const char* end;
    const char* start;
-   cmatch m;
+   typedef BOOST_REGEX_DETAIL_NS::local_allocator<sub_match<const char*> > allocator_type;
+   BOOST_REGEX_DETAIL_NS::local_buffer storage;
+   match_results<const char*, allocator_type> m((allocator_type(storage)));
    
    if(eflags & REG_NOTBOL)
       flags |= match_not_bol;
@@ -244,6 +247,9 @@ BOOST_REGEX_DECL int BOOST_REGEX_CCALL regexecA(const regex_tA* expression, cons
 #endif
    if(expression->re_magic == magic_value)
    {
+      // when the caller has no room for them, don't record the sub-expressions:
+      if(n <= 1)
+         flags = BOOST_REGEX_DETAIL_NS::no_subs_flags(*static_cast<c_regex_type*>(expression->guts), flags);
       result = regex_search(start, end, m, *static_cast<c_regex_type*>(expression->guts), flags);
    }
    else
@@ -28,6 +28,7 @@
 namespace std{
    using ::memcpy;
    using ::memmove;
+   using ::realloc;
 }
 #endif
 
@@ -43,14 +44,12 @@ void BOOST_REGEX_CALL raw_storage::resize(size_type n)
    // extend newsize to WORD/DWORD boundary:
    newsize = (newsize + padding_mask) & ~(padding_mask);
 
-   // allocate and copy data:
-   pointer ptr = static_cast<pointer>(::operator new(newsize));
-   BOOST_REGEX_NOEH_ASSERT(ptr)
-   if(start)
-      std::memcpy(ptr, start, datasize);
-
-   // get rid of old buffer:
-   ::operator delete(start);
+   // grow the buffer, realloc can often do so in place, or without
+   // copying the data for large blocks, either of which saves a lot
+   // of time with very large expressions:
+   pointer ptr = static_cast<pointer>(std::realloc(start, newsize));
+   if(ptr == 0)
+      boost::throw_exception(std::bad_alloc());
 
    // and set up pointers:
    start = ptr;
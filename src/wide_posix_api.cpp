@@ -25,6 +25,7 @@
 
 #include <boost/regex.hpp>
 #include <boost/cregex.hpp>
+#include "internals.hpp"
 
 #include <cwchar>
 #include <cstring>
@@ -240,7 +241,9 @@ BOOST_REGEX_DECL int BOOST_REGEX_CCALL regexecW(const regex_tW* expression, cons
    match_flag_type flags = match_default | expression->eflags;
    const wchar_t* end;
    const wchar_t* start;
-   wcmatch m;
+   typedef BOOST_REGEX_DETAIL_NS::local_allocator<sub_match<const wchar_t*> > allocator_type;
+   BOOST_REGEX_DETAIL_NS::local_buffer storage;
+   match_results<const wchar_t*, allocator_type> m((allocator_type(storage)));
    
    if(eflags & REG_NOTBOL)
       flags |= match_not_bol;
@@ -262,6 +265,9 @@ BOOST_REGEX_DECL int BOOST_REGEX_CCALL regexecW(const regex_tW* expression, cons
 #endif
    if(expression->re_magic == wmagic_value)
    {
+      // when the caller has no room for them, don't record the sub-expressions:
+      if(n <= 1)
+         flags = BOOST_REGEX_DETAIL_NS::no_subs_flags(*static_cast<wc_regex_type*>(expression->guts), flags);
       result = regex_search(start, end, m, *static_cast<wc_regex_type*>(expression->guts), flags);
    }
    else
@@ -0,0 +1,133 @@
+/*
+ *
+ * Copyright (c) 2016
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the 
+ * Boost Software License, Version 1.0. (See accompanying file 
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        stateful_allocator_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Checks that the allocator of a match_results object is
+  *                used for all the storage the matcher needs.
+  */
+
+#include <string>
+#include <cstddef>
+#include <new>
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+
+//
+// A trivial arena, which just counts what is allocated from it:
+//
+struct arena
+{
+   arena() : allocations(0), live(0) {}
+   std::size_t allocations;
+   std::size_t live;
+};
+
+//
+// An allocator which can only be constructed from an arena, so any
+// attempt to default construct one inside the library will not compile:
+//
+template <class T>
+class arena_allocator
+{
+public:
+   typedef T* pointer;
+   typedef const T* const_pointer;
+   typedef T& reference;
+   typedef const T& const_reference;
+   typedef T value_type;
+   typedef std::size_t size_type;
+   typedef std::ptrdiff_t difference_type;
+
+   template <class U>
+   struct rebind
+   {
+      typedef arena_allocator<U> other;
+   };
+
+   explicit arena_allocator(arena* a) : m_arena(a) {}
+   template <class U>
+   arena_allocator(const arena_allocator<U>& a) : m_arena(a.get_arena()) {}
+
+   pointer address(reference r)const { return &r; }
+   const_pointer address(const_reference r)const { return &r; }
+   pointer allocate(size_type n, const void* = 0)
+   {
+      ++m_arena->allocations;
+      ++m_arena->live;
+      return static_cast<pointer>(::operator new(n * sizeof(T)));
+   }
+   void deallocate(pointer p, size_type)
+   {
+      --m_arena->live;
+      ::operator delete(p);
+   }
+   size_type max_size()const { return static_cast<size_type>(-1) / sizeof(T); }
+   void construct(pointer p, const T& val) { new (p) T(val); }
+   void destroy(pointer p) { p->~T(); }
+
+   arena* get_arena()const { return m_arena; }
+private:
+   arena* m_arena;
+};
+
+template <class T, class U>
+bool operator == (const arena_allocator<T>& a, const arena_allocator<U>& b)
+{ return a.get_arena() == b.get_arena(); }
+template <class T, class U>
+bool operator != (const arena_allocator<T>& a, const arena_allocator<U>& b)
+{ return a.get_arena() != b.get_arena(); }
+
+typedef std::string::const_iterator iterator_type;
+typedef boost::match_results<iterator_type, arena_allocator<boost::sub_match<iterator_type> > > results_type;
+
+void check_search(const char* expression, boost::regex::flag_type opts, const std::string& text, const std::string& expected)
+{
+   arena a;
+   {
+      boost::regex e(expression, opts);
+      results_type what((arena_allocator<boost::sub_match<iterator_type> >(&a)));
+      BOOST_CHECK(boost::regex_search(text.begin(), text.end(), what, e));
+      BOOST_CHECK(what.str() == expected);
+      BOOST_CHECK(what.get_allocator().get_arena() == &a);
+      BOOST_CHECK(a.allocations != 0);
+
+      results_type copy(what);
+      BOOST_CHECK(copy.get_allocator().get_arena() == &a);
+      BOOST_CHECK(copy.str() == expected);
+   }
+   BOOST_CHECK_EQUAL(a.live, 0u);
+}
+
+int cpp_main( int , char* [] )
+{
+   // perl matching, recursion and backreferences:
+   check_search("a(b+)c", boost::regex::perl, "xxabbbcxx", "abbbc");
+   check_search("\\((?:[^()]|(?R))*\\)", boost::regex::perl, "x(a(b)(c(d)))y", "(a(b)(c(d)))");
+   check_search("(?<x>\\w)(?&x)\\k<x>", boost::regex::perl, "--abba-aba-", "aba");
+   // POSIX leftmost-longest matching uses a temporary match_results internally:
+   check_search("a(b|bc)*", boost::regex::extended, "xabcbcy", "abcbc");
+
+   // regex_match takes the same path:
+   {
+      arena a;
+      boost::regex e("(\\w+)@(\\w+)");
+      const std::string text("user@host");
+      results_type what((arena_allocator<boost::sub_match<iterator_type> >(&a)));
+      BOOST_CHECK(boost::regex_match(text.begin(), text.end(), what, e));
+      BOOST_CHECK(what[2].str() == "host");
+      BOOST_CHECK(a.allocations != 0);
+   }
+   return 0;
+}
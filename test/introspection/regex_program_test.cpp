@@ -0,0 +1,81 @@
+/*
+ *
+ * Copyright (c) 2016
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        regex_program_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Test the output of print_regex_program.
+  */
+
+#include <string>
+#include <sstream>
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+
+std::string program(const boost::regex& e, boost::regex_program_format f = boost::regex_program_json)
+{
+   std::ostringstream ss;
+   boost::print_regex_program(ss, e, f);
+   return ss.str();
+}
+
+bool contains(const std::string& s, const char* what)
+{
+   return s.find(what) != std::string::npos;
+}
+
+int cpp_main( int , char* [] )
+{
+   std::string s = program(boost::regex("abc"));
+   BOOST_CHECK(contains(s, "\"restart_type\": \"fixed_lit\""));
+   BOOST_CHECK(contains(s, "\"literal_search\": \"applied"));
+   BOOST_CHECK(contains(s, "\"type\": \"literal\", \"next\": 2, \"text\": \"abc\""));
+   BOOST_CHECK(contains(s, "\"type\": \"match\" }"));
+
+   s = program(boost::regex("^\\w+\"?$"));
+   BOOST_CHECK(contains(s, "\"expression\": \"^\\\\w+\\\"?$\""));
+   BOOST_CHECK(contains(s, "\"restart_type\": \"line\""));
+   BOOST_CHECK(contains(s, "\"anchored_search\": \"applied"));
+   BOOST_CHECK(contains(s, "\"leading\": true"));
+   BOOST_CHECK(contains(s, "\"max\": null"));
+
+   s = program(boost::regex("\\d{4}-\\d{4}"));
+   BOOST_CHECK(contains(s, "\"shift_or_length\": 9"));
+   BOOST_CHECK(contains(s, "\"shift_or_search\": \"applied"));
+   BOOST_CHECK(contains(s, "\"startmap\": \"applied"));
+
+   s = program(boost::regex("(a|b)*c"));
+   BOOST_CHECK(contains(s, "\"type\": \"alt\""));
+   BOOST_CHECK(contains(s, "\"take\": \"[a]\", \"skip\": \"[b]\""));
+   BOOST_CHECK(contains(s, "\"memoize\": \"applied"));
+
+   s = program(boost::regex("[^,]*,\\d+\\s"));
+   BOOST_CHECK(contains(s, "\"possessive_repeats\": \"applied"));
+   BOOST_CHECK(!contains(s, "\"possessive\": false"));
+   s = program(boost::regex("\\w+\\d|a*$"));
+   BOOST_CHECK(contains(s, "\"possessive_repeats\": \"not applied"));
+   BOOST_CHECK(!contains(s, "\"possessive\": true"));
+
+   s = program(boost::regex("(a|b)*c"), boost::regex_program_dot);
+   BOOST_CHECK(contains(s, "digraph regex {"));
+   BOOST_CHECK(contains(s, "[style=dashed, label=\"alt\"]"));
+   BOOST_CHECK(contains(s, "restart_type: any\\l"));
+
+   s = program(boost::regex("(?<x>a(?&x)?b)"), boost::regex_program_dot);
+   BOOST_CHECK(contains(s, "label=\"call\""));
+
+   s = program(boost::regex());
+   BOOST_CHECK(s == "{\n  \"states\": []\n}\n");
+
+   return 0;
+}
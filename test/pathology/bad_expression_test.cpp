@@ -17,6 +17,7 @@
   */
 
 #include <string>
+#include <list>
 #include <boost/regex.hpp>
 #include <boost/detail/lightweight_main.hpp>
 #include "../test_macros.hpp"
@@ -55,6 +56,48 @@ int cpp_main( int , char* [] )
    good_text.assign((std::string::size_type)5000, 'a');
    BOOST_CHECK(0 == boost::regex_search(good_text, what, e2));
 
+   //
+   // Memoizing failed repeats makes the nested repeat tractable:
+   //
+   bad_text.assign(1024, ' ');
+   good_text.assign(200, ' ');
+   good_text.append("xyz");
+   BOOST_CHECK(0 == boost::regex_search(bad_text, what, e1, boost::match_default | boost::match_memoize));
+   BOOST_CHECK(boost::regex_search(good_text, what, e1, boost::match_default | boost::match_memoize));
+   BOOST_CHECK(what.length() == 203);
+   bad_text.assign(1024, 'a');
+   e2.assign("(a|aa)+b");
+   BOOST_CHECK(0 == boost::regex_search(bad_text, what, e2, boost::match_default | boost::match_memoize));
+   //
+   // Short texts are memoized without being asked:
+   //
+   bad_text.assign(40, 'a');
+   BOOST_CHECK(0 == boost::regex_search(bad_text, what, e2));
+   BOOST_CHECK(0 == boost::regex_match(bad_text, what, e2));
+   BOOST_CHECK(0 == boost::regex_search(bad_text.c_str(), e2));
+   bad_text.append("b");
+   BOOST_CHECK(boost::regex_match(bad_text, what, e2));
+   BOOST_CHECK(what[1].first == bad_text.end() - 2);
+   //
+   // And can be rejected up front:
+   //
+   BOOST_CHECK_THROW(boost::regex("(.+)+xyz", boost::regex::perl | boost::regex::no_backtracking_hazards), boost::regex_error);
+   BOOST_CHECK_THROW(boost::regex("(a|aa)+b", boost::regex::perl | boost::regex::no_backtracking_hazards), boost::regex_error);
+   BOOST_CHECK_THROW(boost::regex("^(\\w+\\s?)*$", boost::regex::perl | boost::regex::no_backtracking_hazards), boost::regex_error);
+   e2.assign("(ab|cd)*x+y", boost::regex::perl | boost::regex::no_backtracking_hazards);
+   BOOST_CHECK(boost::regex_search(std::string("abcdxxy"), e2));
+   //
+   // Searches which keep growing and shrinking the stack without failing
+   // a state are stopped by the state limit, rather than running indefinitely:
+   //
+   bad_text.clear();
+   for(int i = 0; i < 20; ++i)
+      bad_text.append("\naaxax \n\nbx  \n\na");
+   e2.assign("(?:b+|((?:.*?)*)*)(?!(){2,})+(a)+[ab](?=c)");
+   BOOST_CHECK_THROW(boost::regex_search(bad_text, what, e2), std::runtime_error);
+   std::list<char> bad_list(bad_text.begin(), bad_text.begin() + 16);
+   BOOST_CHECK_THROW(boost::regex_search(bad_list.begin(), bad_list.end(), e2), std::runtime_error);
+
    return 0;
 }
 
@@ -0,0 +1,173 @@
+/*
+ *
+ * Copyright (c) 2016
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        budget_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Test that a match_budget stops a search without throwing.
+  */
+
+#include <string>
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+
+static int callback_count = 0;
+
+bool give_up_after_three(void*)
+{
+   return ++callback_count < 3;
+}
+
+int cpp_main( int , char* [] )
+{
+   std::string bad_text(1024, ' ');
+   std::string good_text(200, ' ');
+   good_text.append("xyz");
+
+   boost::smatch what;
+   boost::regex e1("(.+)+xyz");
+
+   //
+   // A budget large enough for the job changes nothing:
+   //
+   boost::match_budget budget(1000000);
+   BOOST_CHECK(boost::regex_search(good_text, what, e1, budget));
+   BOOST_CHECK(what.length() == 203);
+   BOOST_CHECK(!budget.exhausted());
+   BOOST_CHECK(boost::regex_match(good_text, what, e1, budget));
+   BOOST_CHECK(budget.status() == boost::match_budget::budget_ok);
+   //
+   // One which is too small stops the search, and the matcher can still be used:
+   //
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e1, budget));
+   BOOST_CHECK(budget.status() == boost::match_budget::budget_states_exhausted);
+   BOOST_CHECK(budget.states_used() > 1000000);
+   BOOST_CHECK(!boost::regex_match(bad_text, what, e1, budget));
+   BOOST_CHECK(budget.status() == boost::match_budget::budget_states_exhausted);
+   BOOST_CHECK(!boost::regex_search(bad_text.begin(), bad_text.end(), e1, budget));
+   BOOST_CHECK(budget.status() == boost::match_budget::budget_states_exhausted);
+   BOOST_CHECK(boost::regex_search(good_text, what, e1, budget));
+   BOOST_CHECK(!budget.exhausted());
+   //
+   // The library's own limit still applies:
+   //
+   budget.set_max_states(0);
+   BOOST_CHECK_THROW(boost::regex_search(bad_text, what, e1, budget), std::runtime_error);
+   //
+   // Cancellation:
+   //
+   volatile bool cancel = true;
+   budget.set_cancel_flag(&cancel);
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e1, budget));
+   BOOST_CHECK(budget.status() == boost::match_budget::budget_cancelled);
+   BOOST_CHECK(budget.states_used() <= 2 * budget.check_interval());
+   cancel = false;
+   budget.set_check_interval(100);
+   budget.set_callback(&give_up_after_three, 0);
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e1, budget));
+   BOOST_CHECK(budget.status() == boost::match_budget::budget_cancelled);
+   BOOST_CHECK(callback_count == 3);
+   BOOST_CHECK(budget.states_used() < 1000);
+   //
+   // Processor time:
+   //
+   boost::match_budget timer;
+   timer.set_max_clock(CLOCKS_PER_SEC / 100);
+   bad_text.assign(5000, 'a');
+   boost::regex e2("(a|aa)+b");
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e2, timer));
+   BOOST_CHECK(timer.status() == boost::match_budget::budget_time_exhausted);
+   //
+   // Statistics:
+   //
+   boost::match_statistics stats;
+   boost::match_budget observer;
+   observer.set_statistics(&stats);
+   good_text.assign(200, ' ');
+   good_text.append("xyz");
+   BOOST_CHECK(boost::regex_search(good_text, what, e1, observer));
+   BOOST_CHECK(stats.states == observer.states_used());
+   BOOST_CHECK(stats.states > 0);
+   BOOST_CHECK(stats.attempts == 1);
+   BOOST_CHECK(stats.searched == good_text.size());
+   BOOST_CHECK(stats.restart_type == boost::regbase::restart_any);
+   BOOST_CHECK(!stats.used_shift_or);
+   // the text is short enough to be memoized without asking:
+   BOOST_CHECK(stats.memoized);
+#ifndef BOOST_REGEX_RECURSIVE
+   BOOST_CHECK(!stats.recursive);
+   BOOST_CHECK(stats.stack_blocks >= 1);
+   boost::uintmax_t backtracks = 0;
+   for(unsigned i = 0; i < boost::match_statistics::backtrack_types; ++i)
+      backtracks += stats.backtracks[i];
+   BOOST_CHECK(backtracks > 0);
+   BOOST_CHECK(stats.backtracks[boost::match_statistics::backtrack_types - 1] > 0);
+   BOOST_CHECK(std::string(boost::match_statistics::backtrack_name(4)) == "alt");
+#else
+   BOOST_CHECK(stats.recursive);
+#endif
+   bad_text.assign(1024, ' ');
+   BOOST_CHECK_THROW(boost::regex_search(bad_text, what, e1, observer), std::runtime_error);
+   BOOST_CHECK(stats.states > 1024 * 1024);
+   BOOST_CHECK(!stats.memoized);
+   BOOST_CHECK(stats.attempts == 1);
+   e2.assign("\\d{4}-\\d{4}");
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e2, observer));
+   BOOST_CHECK(stats.used_shift_or);
+   BOOST_CHECK(stats.attempts == 0);
+   BOOST_CHECK(stats.states == 0);
+   e2.assign("^abc");
+   bad_text.assign("abd\nabe\nabc");
+   BOOST_CHECK(boost::regex_search(bad_text, what, e2, observer));
+   BOOST_CHECK(stats.restart_type == boost::regbase::restart_line);
+   BOOST_CHECK(stats.attempts == 3);
+   //
+   // A search which keeps succeeding, without ever failing a state, is checked just as often:
+   //
+   std::string loop_text;
+   for(int i = 0; i < 20; ++i)
+      loop_text.append("\naaxax \n\nbx  \n\na");
+   boost::regex e3("(?:b+|((?:.*?)*)*)(?!(){2,})+(a)+[ab](?=c)");
+   boost::match_budget tiny(1000);
+   BOOST_CHECK(!boost::regex_search(loop_text, what, e3, tiny));
+   BOOST_CHECK(tiny.status() == boost::match_budget::budget_states_exhausted);
+   BOOST_CHECK(tiny.states_used() < 10000);
+   tiny.set_max_states(0);
+   cancel = true;
+   tiny.set_cancel_flag(&cancel);
+   BOOST_CHECK(!boost::regex_search(loop_text, what, e3, tiny));
+   BOOST_CHECK(tiny.status() == boost::match_budget::budget_cancelled);
+   BOOST_CHECK(tiny.states_used() < 10000);
+
+#ifndef BOOST_REGEX_RECURSIVE
+   //
+   // The backtracking stack can grow beyond the library's default limit when the budget allows,
+   // using ever larger blocks as it does so:
+   //
+   bad_text.assign(1000000, 'a');
+   e2.assign("(a)*");
+   BOOST_CHECK_THROW(boost::regex_search(bad_text, what, e2), std::runtime_error);
+   observer.set_max_stack(static_cast<std::size_t>(1) << 30);
+   BOOST_CHECK(boost::regex_search(bad_text, what, e2, observer));
+   BOOST_CHECK(what.length() == 1000000);
+   BOOST_CHECK(observer.status() == boost::match_budget::budget_ok);
+   BOOST_CHECK(stats.stack_size > BOOST_REGEX_MAX_BLOCKS * BOOST_REGEX_BLOCKSIZE);
+   BOOST_CHECK(stats.stack_blocks < stats.stack_size / BOOST_REGEX_BLOCKSIZE / 8);
+   observer.set_max_stack(65536);
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e2, observer));
+   BOOST_CHECK(observer.status() == boost::match_budget::budget_stack_exhausted);
+   BOOST_CHECK(stats.stack_size <= 65536);
+#endif
+
+   return 0;
+}
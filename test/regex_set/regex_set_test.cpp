@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright (c) 2016
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        regex_set_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Test that a regex_set finds the same matches as the
+  *                equivalent alternation, as its members change.
+  */
+
+#include <string>
+#include <vector>
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+
+//
+// Compares a search with s against one with the alternation of its members:
+//
+void check_search(const boost::regex_set& s, const std::vector<std::string>& members, const std::string& text)
+{
+   std::string alternation;
+   for(std::vector<std::string>::const_iterator i = members.begin(); i != members.end(); ++i)
+   {
+      if(i != members.begin())
+         alternation += '|';
+      alternation += "(" + *i + ")";
+   }
+   boost::regex e(alternation, s.flags() | boost::regex::nosubs);
+   boost::smatch what, expected;
+   bool found = boost::regex_search(text, expected, e);
+   BOOST_CHECK(s.search(text, what) == found);
+   BOOST_CHECK(s.search(text) == found);
+   if(found)
+   {
+      BOOST_CHECK(what.size() == 1);
+      BOOST_CHECK(what.position() == expected.position());
+      BOOST_CHECK(what.length() == expected.length());
+   }
+}
+
+int cpp_main( int , char* [] )
+{
+   static const char* const words[] = { "http://foo", "https://bar", "ba", "bar", "(?i)BAZ", "qux\\d+", "x", "ht+p" };
+   static const char* const texts[] = { "", "https://bar", "xhttps://baz", "qux12 baz", "http://fo QUX1 bA", "httttp", "BAZ https://bar" };
+
+   boost::regex_set_builder builder(boost::regex::perl, 2);
+   std::vector<std::string> members;
+   BOOST_CHECK(builder.empty());
+   BOOST_CHECK(!builder.build().search(std::string("abc")));
+   for(unsigned i = 0; i < sizeof(words) / sizeof(words[0]); ++i)
+   {
+      BOOST_CHECK(builder.insert(words[i]));
+      members.push_back(words[i]);
+   }
+   BOOST_CHECK(!builder.insert("ba"));
+   BOOST_CHECK(builder.size() == members.size());
+   BOOST_CHECK(builder.contains("x"));
+
+   boost::regex_set first = builder.build();
+   BOOST_CHECK(first.size() == members.size());
+   BOOST_CHECK(first.parts() == 4);
+   for(unsigned t = 0; t < sizeof(texts) / sizeof(texts[0]); ++t)
+      check_search(first, members, texts[t]);
+   // (?i) applies only to the member containing it:
+   BOOST_CHECK(!first.search(std::string("HTTP://FOO")));
+   BOOST_CHECK(first.match(std::string("baz")));
+   BOOST_CHECK(!first.match(std::string("bazz")));
+
+   //
+   // Remove and add members, the set built earlier is unchanged:
+   //
+   BOOST_CHECK(builder.erase("ba"));
+   BOOST_CHECK(builder.erase("bar"));
+   BOOST_CHECK(!builder.erase("bar"));
+   BOOST_CHECK(builder.insert("https?://\\w+"));
+   members.erase(members.begin() + 2, members.begin() + 4);
+   members.push_back("https?://\\w+");
+   boost::regex_set second = builder.build();
+   BOOST_CHECK(second.size() == members.size());
+   BOOST_CHECK(second.parts() == 4);
+   for(unsigned t = 0; t < sizeof(texts) / sizeof(texts[0]); ++t)
+      check_search(second, members, texts[t]);
+   BOOST_CHECK(first.search(std::string("bar")));
+   BOOST_CHECK(!second.search(std::string("bar")));
+
+   //
+   // Members which are not complete expressions, or which refer to
+   // sub-expressions, are rejected and leave the set as it was:
+   //
+   BOOST_CHECK_THROW(builder.insert("a)|(b"), boost::regex_error);
+   BOOST_CHECK_THROW(builder.insert("(?x)a # comment"), boost::regex_error);
+   BOOST_CHECK_THROW(builder.insert("(a)\\1"), boost::regex_error);
+   BOOST_CHECK_THROW(builder.insert("a(?1)?(b)"), boost::regex_error);
+   BOOST_CHECK_THROW(builder.insert("[a-"), boost::regex_error);
+   BOOST_CHECK(builder.size() == members.size());
+   BOOST_CHECK_THROW(boost::regex_set_builder(boost::regex::basic), std::invalid_argument);
+
+   //
+   // POSIX extended syntax finds the longest of the leftmost matches:
+   //
+   boost::regex_set_builder posix(boost::regex::extended, 1);
+   posix.insert("ab");
+   posix.insert("abcd");
+   posix.insert("b");
+   boost::regex_set s3 = posix.build();
+   boost::smatch what;
+   BOOST_CHECK(s3.search(std::string("xabcd"), what));
+   BOOST_CHECK(what.position() == 1);
+   BOOST_CHECK(what.length() == 4);
+
+   builder.clear();
+   BOOST_CHECK(builder.build().empty());
+   BOOST_CHECK(!second.empty());
+   return 0;
+}
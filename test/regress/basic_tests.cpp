@@ -37,6 +37,9 @@ void basic_tests()
    TEST_REGEX_SEARCH("a", basic, "bba", match_default, make_array(2, 3, -2, -2));
    TEST_REGEX_SEARCH("Z", perl, "aaa", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH("Z", perl, "xxxxZZxxx", match_default, make_array(4, 5, -2, 5, 6, -2, -2));
+   TEST_REGEX_SEARCH("abc", perl, "xxabxabcxxabc", match_default, make_array(5, 8, -2, 10, 13, -2, -2));
+   TEST_REGEX_SEARCH("abc", perl|icase, "xxABxAbCxxabc", match_default, make_array(5, 8, -2, 10, 13, -2, -2));
+   TEST_REGEX_SEARCH("(?i)abc", perl, "xxABxAbCxxabc", match_default, make_array(5, 8, -2, 10, 13, -2, -2));
    // and some simple brackets:
    TEST_REGEX_SEARCH("(a)", perl, "zzzaazz", match_default, make_array(3, 4, 3, 4, -2, 4, 5, 4, 5, -2, -2));
    TEST_REGEX_SEARCH("()", perl, "zzz", match_default, make_array(0, 0, 0, 0, -2, 1, 1, 1, 1, -2, 2, 2, 2, 2, -2, 3, 3, 3, 3, -2, -2));
@@ -54,6 +57,22 @@ void basic_tests()
    TEST_INVALID_REGEX("(\\)", perl);
    TEST_REGEX_SEARCH("p(a)rameter", perl, "ABCparameterXYZ", match_default, make_array(3, 12, 4, 5, -2, -2));
    TEST_REGEX_SEARCH("[pq](a)rameter", perl, "ABCparameterXYZ", match_default, make_array(3, 12, 4, 5, -2, -2));
+   // fixed length sequences, these are found with a bit-parallel search:
+   TEST_REGEX_SEARCH("a(b.)(c)d", perl, "xxab\ncdxabzcd", match_default, make_array(2, 7, 3, 5, 5, 6, -2, 8, 13, 9, 11, 11, 12, -2, -2));
+   TEST_REGEX_SEARCH("a(b.)(c)d", perl, "xxab\ncdxabzcd", match_not_dot_newline, make_array(8, 13, 9, 11, 11, 12, -2, -2));
+   TEST_REGEX_SEARCH("a(b.)(c)d", perl, "xxab\ncdxabzcd", match_nosubs, make_array(2, 7, -2, 8, 13, -2, -2));
+   TEST_REGEX_SEARCH("[a-c]((x){2})", perl|icase, "zzBXxqcxxx", match_default, make_array(2, 5, 3, 5, 4, 5, -2, 6, 9, 7, 9, 8, 9, -2, -2));
+   TEST_REGEX_SEARCH("a(?i)b[cd].", perl, "ABcdaBcdaBDe", match_default, make_array(4, 8, -2, 8, 12, -2, -2));
+   TEST_REGEX_SEARCH("[a-c](x{2})", perl|icase, "zzBXxqcxxx", match_default, make_array(2, 5, 3, 5, -2, 6, 9, 7, 9, -2, -2));
+   TEST_REGEX_SEARCH("a[bc]{3}d", extended, "abcbcdabbbd", match_default, make_array(6, 11, -2, -2));
+   TEST_REGEX_SEARCH("(?i)aBaB[x_]", perl, "abaaBAbX ABAB_", match_default, make_array(3, 8, -2, 9, 14, -2, -2));
+   TEST_REGEX_SEARCH("b[b.-]{2}a", perl, "bb.bb-ab", match_default, make_array(3, 7, -2, -2));
+   TEST_REGEX_SEARCH("0123456789x{57}", perl, "00123456789xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", match_default, make_array(1, 68, -2, -2));
+   // case insensitive literals, repeats and sets:
+   TEST_REGEX_SEARCH("Needle", perl|icase, "a NEEDLE and a needle", match_default, make_array(2, 8, -2, 15, 21, -2, -2));
+   TEST_REGEX_SEARCH("xA+[b-d]*Y", perl|icase, "XaAaBcdyxay", match_default, make_array(0, 8, -2, 8, 11, -2, -2));
+   TEST_REGEX_SEARCH("(?i)q{2,}z", perl, "qQqZ", match_default, make_array(0, 4, -2, -2));
+   TEST_REGEX_SEARCH("ab(?i)c+(?-i)d", perl, "abCcDabcCd", match_default, make_array(5, 10, -2, -2));
 
    // now try escaped brackets:
    TEST_REGEX_SEARCH("\\(a\\)", basic, "zzzaazz", match_default, make_array(3, 4, 3, 4, -2, 4, 5, 4, 5, -2, -2));
@@ -40,6 +40,21 @@ void test_alt()
    TEST_INVALID_REGEX("(|a)", perl|no_empty_expressions);
    TEST_REGEX_SEARCH("(|a)", perl, " a", match_default, make_array(0, 0, 0, 0, -2, 1, 1, 1, 1, -2, 1, 2, 1, 2, -2, 2, 2, 2, 2, -2, -2));
    TEST_REGEX_SEARCH("a\\|", perl, "a|", match_default, make_array(0, 2, -2, -2));
+   // alternatives with a common leading literal are factored, but still match in order:
+   TEST_REGEX_SEARCH("http://foo|https://bar|http://baz", perl, "http://baz", match_default, make_array(0, 10, -2, -2));
+   TEST_REGEX_SEARCH("http://foo|https://bar|http://baz", perl, "https://bar", match_default, make_array(0, 11, -2, -2));
+   TEST_REGEX_SEARCH("http://foo|https://bar|http://baz", perl, "http://bar", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("abc|abd|ab|x|aby", perl, "aby", match_default, make_array(0, 2, -2, -2));
+   TEST_REGEX_SEARCH("abc|abd|ab|x|aby", perl, "xabd", match_default, make_array(0, 1, -2, 1, 4, -2, -2));
+   TEST_REGEX_SEARCH("ab|abc", perl, "abc", match_default, make_array(0, 2, -2, -2));
+   TEST_REGEX_SEARCH("ab|abc", extended, "abc", match_default, make_array(0, 3, -2, -2));
+   TEST_REGEX_SEARCH("(ab(c)|abd|(a)bx)", perl, "abx", match_default, make_array(0, 3, 0, 3, -1, -1, 0, 1, -2, -2));
+   TEST_REGEX_SEARCH("(ab(c)|abd|(a)bx)", perl, "abc", match_default, make_array(0, 3, 0, 3, 2, 3, -1, -1, -2, -2));
+   TEST_REGEX_SEARCH("Ab|aB|(?i)ac", perl, "AC", match_default, make_array(0, 2, -2, -2));
+   TEST_REGEX_SEARCH("Ab|aB|(?i)ac", perl, "ab", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("ab|ac|ad", perl|icase, "xAD", match_default, make_array(1, 3, -2, -2));
+   TEST_REGEX_SEARCH("(?<=ab|ac|bd)x", perl, "acx", match_default, make_array(2, 3, -2, -2));
+   TEST_REGEX_SEARCH("(?<!ab|ac)x", perl, "acxbx", match_default, make_array(4, 5, -2, -2));
 
    TEST_REGEX_SEARCH("a|", basic, "a|", match_default, make_array(0, 2, -2, -2));
    TEST_REGEX_SEARCH("a\\|", basic, "a|", match_default, make_array(0, 2, -2, -2));
@@ -26,6 +26,9 @@ void test_anchors()
    TEST_REGEX_SEARCH("ab$", boost::regex::extended, "abxx", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH("ab$", boost::regex::extended, "ab\nzz", match_default, make_array(0, 2, -2, -2));
    TEST_REGEX_SEARCH("^ab", boost::regex::extended, "\n\n  a", match_default, make_array(-2, -2));
+   // long lines, whose separators are searched for several characters at a time:
+   TEST_REGEX_SEARCH("^ab", perl, "xxxxxxxxxxxxxxxx\nabxxxxxxxxxxxxxxx\rab\fxxxxxxxxxxxxxxxxxxab\fab", match_default, make_array(17, 19, -2, 35, 37, -2, 59, 61, -2, -2));
+   TEST_REGEX_SEARCH("^ab", perl, "\xff\xff\xff\xff\xff\xff\xff\xff\x8c\x8d\x8a\rab", match_default, make_array(12, 14, -2, -2));
 
    TEST_REGEX_SEARCH("^ab", basic, "ab", match_default, make_array(0, 2, -2, -2));
    TEST_REGEX_SEARCH("^ab", basic, "xxabxx", match_default, make_array(-2, -2));
@@ -76,6 +76,42 @@ int get_posix_match_flags(boost::regex_constants::match_flag_type f)
    return result;
 }
 
+//
+// Checks the results of a search with class RegEx, held either in
+// the RegEx object itself, or in a RegExMatch:
+//
+template <class R>
+void check_RegEx_results(const R& r, const int* results)
+{
+   int i = 0;
+   while(results[i*2] != -2)
+   {
+      if(r.Matched(i))
+      {
+         if(results[2*i] != static_cast<int>(r.Position(i)))
+         {
+            BOOST_REGEX_TEST_ERROR("Mismatch in start of subexpression " << i << " found with the RegEx class (found " << r.Position(i) << " expected " << results[2*i] << ").", char);
+         }
+         if(results[2*i+1] != static_cast<int>(r.Position(i) + r.Length(i)))
+         {
+            BOOST_REGEX_TEST_ERROR("Mismatch in end of subexpression " << i << " found with the RegEx class (found " << r.Position(i) + r.Length(i) << " expected " << results[2*i+1] << ").", char);
+         }
+      }
+      else
+      {
+         if(results[2*i] >= 0)
+         {
+            BOOST_REGEX_TEST_ERROR("Mismatch in start of subexpression " << i << " found with the RegEx class (found " << r.Position(i) << " expected " << results[2*i] << ").", char);
+         }
+         if(results[2*i+1] >= 0)
+         {
+            BOOST_REGEX_TEST_ERROR("Mismatch in end of subexpression " << i << " found with the RegEx class (found " << r.Position(i) + r.Length(i) << " expected " << results[2*i+1] << ").", char);
+         }
+      }
+      ++i;
+   }
+}
+
 void test_deprecated(const char&, const test_regex_search_tag&)
 {
    const std::string& expression = test_info<char>::expression();
@@ -128,6 +164,22 @@ void test_deprecated(const char&, const test_regex_search_tag&)
          BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" was not found with the POSIX C API.", char);
       }
    }
+   // and again with room for the whole match only, and for nothing at all:
+   if(boost::regexecA(&re, search_text.c_str(), 1, matches, posix_match_options) == 0)
+   {
+      if((results[0] != matches[0].rm_so) || (results[1] != matches[0].rm_eo))
+      {
+         BOOST_REGEX_TEST_ERROR("Mismatch in the whole match found with the POSIX C API when only one regmatch_t was supplied.", char);
+      }
+   }
+   else if(results[0] >= 0)
+   {
+      BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" was not found with the POSIX C API when only one regmatch_t was supplied.", char);
+   }
+   if((boost::regexecA(&re, search_text.c_str(), 0, 0, posix_match_options) == 0) != (results[0] >= 0))
+   {
+      BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" gave the wrong result with the POSIX C API when no regmatch_t's were supplied.", char);
+   }
    // clean up whatever:
    boost::regfreeA(&re);
 
@@ -147,41 +199,36 @@ void test_deprecated(const char&, const test_regex_search_tag&)
       }
       if(e.Search(search_text, test_info<char>::match_options()))
       {
-         int i = 0;
-         while(results[i*2] != -2)
+         check_RegEx_results(e, results);
+      }
+      else
+      {
+         if(results[0] >= 0)
          {
-            if(e.Matched(i))
-            {
-               if(results[2*i] != static_cast<int>(e.Position(i)))
-               {
-                  BOOST_REGEX_TEST_ERROR("Mismatch in start of subexpression " << i << " found with the RegEx class (found " << e.Position(i) << " expected " << results[2*i] << ").", char);
-               }
-               if(results[2*i+1] != static_cast<int>(e.Position(i) + e.Length(i)))
-               {
-                  BOOST_REGEX_TEST_ERROR("Mismatch in end of subexpression " << i << " found with the RegEx class (found " << e.Position(i) + e.Length(i) << " expected " << results[2*i+1] << ").", char);
-               }
-            }
-            else
-            {
-               if(results[2*i] >= 0)
-               {
-                  BOOST_REGEX_TEST_ERROR("Mismatch in start of subexpression " << i << " found with the RegEx class (found " << e.Position(i) << " expected " << results[2*i] << ").", char);
-               }
-               if(results[2*i+1] >= 0)
-               {
-                  BOOST_REGEX_TEST_ERROR("Mismatch in end of subexpression " << i << " found with the RegEx class (found " << e.Position(i) + e.Length(i) << " expected " << results[2*i+1] << ").", char);
-               }
-            }
-            ++i;
+            BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" was not found with class RegEx.", char);
          }
       }
+      //
+      // and through the const interface, which leaves the results in a RegExMatch:
+      //
+      const boost::RegEx& ce = e;
+      boost::RegExMatch what;
+      if(ce.Search(search_text, what, test_info<char>::match_options()))
+      {
+         check_RegEx_results(what, results);
+      }
       else
       {
          if(results[0] >= 0)
          {
-            BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" was not found with class RegEx.", char);
+            BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" was not found with class RegExMatch.", char);
          }
       }
+      // whether or not anything matched:
+      if(what.Marks() != e.Marks())
+      {
+         BOOST_REGEX_TEST_ERROR("Mismatch in the number of subexpressions found with class RegExMatch (found " << what.Marks() << " expected " << e.Marks() << ").", char);
+      }
    }
 #ifndef BOOST_NO_EXCEPTIONS
    catch(const boost::bad_expression& r)
@@ -256,6 +303,22 @@ void test_deprecated(const wchar_t&, const test_regex_search_tag&)
          BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" was not found with the POSIX C API.", wchar_t);
       }
    }
+   // and again with room for the whole match only, and for nothing at all:
+   if(boost::regexecW(&re, search_text.c_str(), 1, matches, posix_match_options) == 0)
+   {
+      if((results[0] != matches[0].rm_so) || (results[1] != matches[0].rm_eo))
+      {
+         BOOST_REGEX_TEST_ERROR("Mismatch in the whole match found with the POSIX C API when only one regmatch_t was supplied.", wchar_t);
+      }
+   }
+   else if(results[0] >= 0)
+   {
+      BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" was not found with the POSIX C API when only one regmatch_t was supplied.", wchar_t);
+   }
+   if((boost::regexecW(&re, search_text.c_str(), 0, 0, posix_match_options) == 0) != (results[0] >= 0))
+   {
+      BOOST_REGEX_TEST_ERROR("Expression : \"" << expression.c_str() << "\" gave the wrong result with the POSIX C API when no regmatch_t's were supplied.", wchar_t);
+   }
    // clean up whatever:
    boost::regfreeW(&re);
 #endif
@@ -12,6 +12,7 @@
 #include "test.hpp"
 #include <iostream>
 #include <iomanip>
+#include <list>
 
 #if !BOOST_WORKAROUND(BOOST_MSVC, <= 1300)\
    && !BOOST_WORKAROUND(__HP_aCC, BOOST_TESTED_AT(55500))\
@@ -159,6 +160,94 @@ void test_operators()
    test_plus(*s2.c_str(), sub1, "ba");
    test_plus(sub2, s1, "ba");
    test_plus(s2, sub1, "ba");
+
+   //
+   // Comparisons work on the matched characters directly, check that they
+   // still order things as std::basic_string does:
+   //
+   std::string s3("ab");
+   std::string s4("\xff");
+   boost::sub_match<std::string::const_iterator> sub3, sub4, empty, unmatched;
+   sub3.first = s3.begin();
+   sub3.second = s3.end();
+   sub3.matched = true;
+   sub4.first = s4.begin();
+   sub4.second = s4.end();
+   sub4.matched = true;
+   empty.first = empty.second = s3.begin();
+   empty.matched = true;
+   test_less(sub1, sub3);
+   test_less(sub1, s3);
+   test_less(sub1, s3.c_str());
+   test_greater(sub3, sub1);
+   test_greater(sub3, *s1.c_str());
+   test_less(sub3, *s2.c_str());
+   test_greater(sub4, sub3);
+   test_greater(sub4, s3.c_str());
+   test_less(s3, sub4);
+   test_less(unmatched, empty);
+   test_less(unmatched, sub1);
+   test_equal(unmatched, unmatched);
+   test_equal(unmatched, "");
+   test_equal(empty, "");
+   test_equal(empty, std::string());
+   // pointers:
+   const char* p3 = s3.c_str();
+   boost::csub_match csub;
+   csub.first = p3;
+   csub.second = p3 + 2;
+   csub.matched = true;
+   test_equal(csub, s3);
+   test_equal(csub, "ab");
+   test_less(csub, "abc");
+   test_greater(csub, "a");
+   // iterators which don't refer to contiguous characters:
+   std::list<char> l3(s3.begin(), s3.end());
+   boost::sub_match<std::list<char>::const_iterator> lsub;
+   lsub.first = l3.begin();
+   lsub.second = l3.end();
+   lsub.matched = true;
+   test_equal(lsub, s3);
+   test_equal(lsub, "ab");
+   test_greater(lsub, s1);
+   test_less(lsub, *s2.c_str());
+   test_less(lsub, s4.c_str());
+
+   //
+   // Hashing depends only on the characters matched:
+   //
+   std::string s5("xab");
+   boost::sub_match<std::string::const_iterator> sub5;
+   sub5.first = s5.begin() + 1;
+   sub5.second = s5.end();
+   sub5.matched = true;
+   boost::hash<boost::sub_match<std::string::const_iterator> > h;
+   if(h(sub3) != h(sub5))
+   {
+      BOOST_REGEX_TEST_ERROR("Equal sub_match's have different hash values", char);
+   }
+   if(boost::hash_value(lsub) != h(sub3))
+   {
+      BOOST_REGEX_TEST_ERROR("Equal sub_match's have different hash values", char);
+   }
+#ifndef BOOST_NO_CXX11_HDR_FUNCTIONAL
+   if(std::hash<boost::sub_match<std::string::const_iterator> >()(sub3) != h(sub5))
+   {
+      BOOST_REGEX_TEST_ERROR("std::hash differs from boost::hash for sub_match", char);
+   }
+#endif
+
+   //
+   // Views of contiguous characters:
+   //
+   if((sub5.view().size() != 2) || (sub5.view().data() != s5.c_str() + 1) || (sub5.view() != boost::string_ref("ab")))
+   {
+      BOOST_REGEX_TEST_ERROR("sub_match::view returned the wrong characters", char);
+   }
+   if(!unmatched.view().empty() || !empty.view().empty() || (csub.view().data() != p3))
+   {
+      BOOST_REGEX_TEST_ERROR("sub_match::view returned the wrong characters", char);
+   }
 }
 
 #else
@@ -53,4 +53,30 @@ void test_overloads()
    BOOST_REGEX_TEST(boost::regex_search(s, sm, e, boost::regex_constants::match_default))
    BOOST_REGEX_TEST(boost::regex_search(s, e))
    BOOST_REGEX_TEST(boost::regex_search(s, e, boost::regex_constants::match_default))
+   // regex_contains and regex_count:
+   BOOST_REGEX_TEST(boost::regex_contains(cs.begin(), cs.end(), e))
+   BOOST_REGEX_TEST(boost::regex_contains(s.c_str(), e, boost::regex_constants::match_default))
+   BOOST_REGEX_TEST(boost::regex_contains(s, e))
+   BOOST_REGEX_TEST(boost::regex_count(cs.begin(), cs.end(), e) == 1)
+   BOOST_REGEX_TEST(boost::regex_count(s.c_str(), e, boost::regex_constants::match_default) == 1)
+   BOOST_REGEX_TEST(boost::regex_count(s, e) == 1)
+   BOOST_REGEX_TEST(boost::regex_count("abcxabc", e) == 2)
+   BOOST_REGEX_TEST(boost::regex_count("xyz", boost::regex("a*")) == 4)
+   BOOST_REGEX_TEST(boost::regex_count("abab", boost::regex("(ab)\\1")) == 1)
+   // non-destructive regex_split:
+   const char* fields = "a,b,,c";
+   const char* fields_end = fields + 6;
+   const char* pos = fields;
+   std::vector<boost::csub_match> parts;
+   BOOST_REGEX_TEST((boost::regex_split(std::back_inserter(parts), pos, fields_end, boost::regex(",")) == 4) && (pos == fields_end))
+   BOOST_REGEX_TEST((parts.size() == 4) && (parts[0] == "a") && (parts[2].length() == 0) && (parts[3] == "c"))
+   boost::csub_match fixed[2];
+   pos = fields;
+   BOOST_REGEX_TEST((boost::regex_split(fixed, pos, fields_end, boost::regex(",")) == 2) && (fixed[1] == "b") && (pos == fields + 4))
+   // literal searches through narrow character pointers:
+   const char* t = "xxabxabcxx";
+   BOOST_REGEX_TEST(boost::regex_search(t, cm, e) && (cm.position() == 5) && (cm.length() == 3))
+   BOOST_REGEX_TEST(!boost::regex_search(t, t + 7, e))
+   BOOST_REGEX_TEST(boost::regex_search(t, t + 7, cm, e, boost::regex_constants::match_partial) && (cm.position() == 5) && !cm[0].matched)
+   BOOST_REGEX_TEST(boost::regex_search("xxABxAbCxx", cm, boost::regex("abc", boost::regex::icase)) && (cm.position() == 5))
 }
@@ -234,6 +234,10 @@ void test_options2()
    TEST_REGEX_SEARCH("(a(?i)B)c", perl, "ABc", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH("(a(?i)B)c", perl, "ABC", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH("(a(?i)B)c", perl, "AbC", match_default, make_array(-2, -2));
+   // (?i) in a later alternative applies to those after it, but not to earlier ones at the next position:
+   TEST_REGEX_SEARCH("ab|ba|(?i)b|hbac", perl, "hbA", match_default, make_array(1, 2, -2, -2));
+   TEST_REGEX_SEARCH("ab|ba|(?i)b|hbac", perl, "hBac", match_default, make_array(0, 4, -2, -2));
+   TEST_REGEX_SEARCH("ab|ba|(?i)b|hbac", perl, "xbaB", match_default, make_array(1, 3, -2, 3, 4, -2, -2));
    
    TEST_REGEX_SEARCH("a(?i:b)c", perl, "abc", match_default, make_array(0, 3, -2, -2));
    TEST_REGEX_SEARCH("a(?i:b)c", perl, "aBc", match_default, make_array(0, 3, -2, -2));
@@ -814,6 +818,8 @@ void test_recursion()
    TEST_REGEX_SEARCH("\\((?:(?>[^()]+)|(?R))*\\)", perl, "abcd", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH("\\((?:(?>[^()]+)|(?R))*\\)", perl, "abcd)", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH("\\((?:(?>[^()]+)|(?R))*\\)", perl, "(abcd", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("x|a(?R)b", perl, "aaxbb", match_default, make_array(0, 5, -2, -2));
+   TEST_REGEX_SEARCH("a(?R)b|x", perl, "aaxbb", match_default, make_array(0, 5, -2, -2));
 
    TEST_REGEX_SEARCH("\\(  ( (?>[^()]+) | (?R) )* \\) ", perl|mod_x, "(ab(xy)cd)pqr", match_default, make_array(0, 10, 7, 9, -2, -2));
    TEST_REGEX_SEARCH("\\(  ( (?>[^()]+) | (?R) )* \\) ", perl|mod_x, "1(abcd)(x(y)z)pqr", match_default, make_array(1, 7, 2, 6, -2, 7, 14, 12, 13, -2, -2));
@@ -120,6 +120,22 @@ void test_simple_search(boost::basic_regex<charT, traits>& r)
       {
          BOOST_REGEX_TEST_ERROR("Expected match was not found when using the match_any flag.", charT);
       }
+      if(!boost::regex_contains(search_text.begin(), search_text.end(), r, opts))
+      {
+         BOOST_REGEX_TEST_ERROR("Expected match was not found by regex_contains.", charT);
+      }
+      // memoizing failed repeats should have no effect on the result returned:
+      if(!boost::regex_search(
+         search_text.begin(),
+         search_text.end(),
+         what,
+         r,
+         opts|boost::regex_constants::match_memoize))
+      {
+         BOOST_REGEX_TEST_ERROR("Expected match was not found when using the match_memoize flag.", charT);
+      }
+      else
+         test_result(what, search_text.begin(), answer_table);
    }
    else
    {
@@ -137,6 +153,18 @@ void test_simple_search(boost::basic_regex<charT, traits>& r)
       {
          BOOST_REGEX_TEST_ERROR("Unexpected match was found when using the match_any flag.", charT);
       }
+      else if(boost::regex_contains(search_text.begin(), search_text.end(), r, opts))
+      {
+         BOOST_REGEX_TEST_ERROR("Unexpected match was found by regex_contains.", charT);
+      }
+      else if(boost::regex_search(
+         search_text.begin(),
+         search_text.end(),
+         r,
+         opts|boost::regex_constants::match_memoize))
+      {
+         BOOST_REGEX_TEST_ERROR("Unexpected match was found when using the match_memoize flag.", charT);
+      }
    }
 #ifdef TEST_ROPE
    std::rope<charT> rsearch_text;
@@ -185,8 +213,10 @@ void test_regex_iterator(boost::basic_regex<charT, traits>& r)
    test_iterator start(search_text.begin(), search_text.end(), r, opts), end;
    test_iterator copy(start);
    const_iterator last_end = search_text.begin();
+   std::size_t match_count = 0;
    while(start != end)
    {
+      ++match_count;
       if(start != copy)
       {
          BOOST_REGEX_TEST_ERROR("Failed iterator != comparison.", charT);
@@ -233,6 +263,11 @@ void test_regex_iterator(boost::basic_regex<charT, traits>& r)
       // we should have had a match but didn't:
       BOOST_REGEX_TEST_ERROR("Expected match was not found.", charT);
    }
+   // regex_count should see exactly the matches that the iterator did:
+   if(boost::regex_count(search_text.begin(), search_text.end(), r, opts) != match_count)
+   {
+      BOOST_REGEX_TEST_ERROR("regex_count did not agree with the number of matches enumerated by regex_iterator.", charT);
+   }
 }
 
 template<class charT, class traits>
@@ -383,8 +418,11 @@ void test_regex_token_iterator(boost::basic_regex<charT, traits>& r)
       if(start2 != end2)
       {
          test_sub_match(*start2, search_text.begin(), answer_table, 0);
+         test_iterator held(start2);
          ++start2;
          ++copy2;
+         // a copy should be unaffected by the iterator it was copied from moving on:
+         test_sub_match(*held, search_text.begin(), answer_table, 0);
       }
       // move on the answer table to next set of answers;
       if(*answer_table != -2)
@@ -495,6 +533,13 @@ void test(boost::basic_regex<charT, traits>& r, const test_regex_search_tag&)
       test_regex_grep(r);
       test_regex_match(r);
       //
+      // The optimised machine must give the same results:
+      //
+      r.assign(expression, syntax_options | boost::regbase::optimize);
+      test_simple_search(r);
+      test_regex_iterator(r);
+      test_regex_match(r);
+      //
       // Verify sub-expression locations:
       //
 #ifndef BOOST_NO_EXCEPTIONS
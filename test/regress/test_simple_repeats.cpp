@@ -486,5 +486,17 @@ void test_pocessive_repeats()
    TEST_INVALID_REGEX("\\d*++", perl);
    TEST_INVALID_REGEX("\\d?++", perl);
    TEST_INVALID_REGEX("\\d{1,2}++", perl);
+   // greedy repeats which never need to backtrack are made possessive automatically:
+   TEST_REGEX_SEARCH("[^,]*,", perl, "ab,,c", match_default, make_array(0, 3, -2, 3, 4, -2, -2));
+   TEST_REGEX_SEARCH("(\\d+)\\s", perl, "12 345x 6\n", match_default, make_array(0, 3, 0, 2, -2, 8, 10, 8, 9, -2, -2));
+   TEST_REGEX_SEARCH("a{2,4}b", perl, "aaaaab", match_default, make_array(1, 6, -2, -2));
+   TEST_REGEX_SEARCH("a+b", perl|icase, "xAaAB", match_default, make_array(1, 5, -2, -2));
+   TEST_REGEX_SEARCH("a+(?i)b", perl, "aaaB", match_default, make_array(0, 4, -2, -2));
+   TEST_REGEX_SEARCH("[[:digit:]]+[[:alpha:]]", extended, "x123y", match_default, make_array(1, 5, -2, -2));
+   TEST_REGEX_SEARCH("\\d+\\s", perl, "1234", match_partial, make_array(0, 4, -2, -2));
+   // but not when what follows can start with something the repeat matches:
+   TEST_REGEX_SEARCH("a+(?i)A", perl, "aaa", match_default, make_array(0, 3, -2, -2));
+   TEST_REGEX_SEARCH("\\d+(?:x|1)", perl, "111", match_default, make_array(0, 3, -2, -2));
+   TEST_REGEX_SEARCH("(\\d+)\\1", perl, "1212", match_default, make_array(0, 4, 0, 2, -2, -2));
 }
 